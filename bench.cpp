@@ -0,0 +1,1384 @@
+#ifdef NS
+
+#include "fixtures.hpp"
+#include "src/aligned_allocator.hpp"
+#include "src/concurrent_stack.hpp"
+#include "src/deque.hpp"
+#include "src/map.hpp"
+#include "src/pairing_heap.hpp"
+#include "src/parallel.hpp"
+#include "src/priority_queue.hpp"
+#include "src/set.hpp"
+#include "src/small_vector.hpp"
+#include "src/spsc_ring.hpp"
+#include "src/stack.hpp"
+#include "src/vector.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <new>
+#include <numeric>
+#include <pthread.h>
+#include <queue>
+#include <sched.h>
+#include <set>
+#include <sstream>
+#include <stack>
+#include <string>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#ifndef BENCH_REPEAT
+#define BENCH_REPEAT 3
+#endif
+
+#define STRINGIFY( x ) #x
+#define TOSTRING( x ) STRINGIFY( x )
+
+#ifndef BENCH_NAME
+#define BENCH_NAME NS
+#endif
+#ifndef BENCH_REFERENCE
+#define BENCH_REFERENCE std
+#endif
+
+/* ------------------------------- Allocations ------------------------------ */
+
+/*
+ * Every operator new, so element copies count as well as container blocks.
+ * The default operator delete already hands blocks back to free().
+ */
+static std::size_t n_allocation;
+
+/* Out of line, or GCC pairs the inlined malloc() with operator delete */
+#if __cplusplus >= 201103L
+__attribute__( ( noinline ) ) void *operator new( std::size_t size ) {
+#else
+__attribute__( ( noinline ) ) void *operator new( std::size_t size ) throw(
+    std::bad_alloc ) {
+#endif
+    n_allocation++;
+    if ( void *p = std::malloc( size ? size : 1 ) ) { return p; }
+    throw std::bad_alloc();
+}
+
+/* -------------------------------- Stopwatch ------------------------------- */
+
+class Stopwatch {
+    double      _start;
+    double      _seconds;
+    std::size_t _start_allocation;
+    std::size_t _allocations;
+
+    static double _now() {
+        struct timeval tv;
+        gettimeofday( &tv, 0 );
+        return tv.tv_sec + tv.tv_usec * 1e-6;
+    }
+    static std::size_t _n_allocation() { return n_allocation; }
+
+public:
+    Stopwatch()
+        : _start( 0 ),
+          _seconds( 0 ),
+          _start_allocation( 0 ),
+          _allocations( 0 ) {}
+
+    void start() {
+        _start_allocation = _n_allocation();
+        _start            = _now();
+    }
+    void stop() {
+        _seconds     = _now() - _start;
+        _allocations = _n_allocation() - _start_allocation;
+    }
+
+    /* Reports a figure the scenario measured itself, a latency say */
+    void report( double seconds ) { _seconds = seconds; }
+
+    double      seconds() const { return _seconds; }
+    std::size_t allocations() const { return _allocations; }
+};
+
+/* ---------------------------------- Data ---------------------------------- */
+
+typedef A< std::string >                        key_type;
+typedef A< int >                                mapped_type;
+typedef NS::pair< const key_type, mapped_type > value_type;
+
+#if NS_IS_FT
+/* A owns its value through a pointer, its bytes can move anywhere */
+namespace ft {
+template < typename T >
+struct is_trivially_relocatable< A< T > > : public true_type {};
+}
+#endif
+
+/* -------------------------------- Scenarios ------------------------------- */
+
+/* Keeps results the compiler could otherwise prove unused */
+static volatile long sink;
+
+void vector_push_back( Stopwatch &sw ) {
+    typedef NS::vector< mapped_type, Vallocator< mapped_type > > vector_type;
+
+    vector_type v;
+    mapped_type x = F< mapped_type >()();
+
+    sw.start();
+    for ( vector_type::size_type i( 0 ); i < 10000000; i++ ) {
+        v.push_back( x );
+    }
+    sw.stop();
+}
+
+void vector_middle_insert( Stopwatch &sw ) {
+    typedef NS::vector< mapped_type, Vallocator< mapped_type > > vector_type;
+
+    vector_type v( 10000 );
+    mapped_type x = F< mapped_type >()();
+
+    sw.start();
+    for ( int i = 0; i < 20000; i++ ) { v.insert( v.begin() + i / 2, x ); }
+    sw.stop();
+}
+
+void vector_middle_erase( Stopwatch &sw ) {
+    typedef NS::vector< mapped_type, Vallocator< mapped_type > > vector_type;
+
+    vector_type v( 30000 );
+
+    sw.start();
+    while ( v.size() > 10000 ) { v.erase( v.begin() + v.size() / 3 ); }
+    sw.stop();
+}
+
+void vector_pod_erase( Stopwatch &sw ) {
+    typedef NS::vector< int, Vallocator< int > > vector_type;
+
+    vector_type v( 300000 );
+
+    sw.start();
+    while ( v.size() > 100000 ) { v.erase( v.begin() + v.size() / 3 ); }
+    sw.stop();
+}
+
+void vector_stream_insert( Stopwatch &sw ) {
+    typedef NS::vector< int, Vallocator< int > > vector_type;
+    typedef std::istream_iterator< int >         input_iterator;
+
+    std::ostringstream os;
+    for ( int i = 0; i < 500000; i++ ) { os << i << ' '; }
+    std::istringstream is( os.str() );
+    vector_type        v( 1000 );
+
+    sw.start();
+    v.insert( v.begin() + 500, input_iterator( is ), input_iterator() );
+    sw.stop();
+    sink = v.size();
+}
+
+struct Iota {
+    std::size_t operator()( int *p, std::size_t n ) const {
+        for ( std::size_t i = 0; i < n; i++ ) { p[i] = i; }
+        return n;
+    }
+};
+
+/* 1GB of ints, value-initialized then written over */
+void vector_overwrite_value_init( Stopwatch &sw ) {
+    typedef NS::vector< int > vector_type;
+
+    sw.start();
+    vector_type v( 1 << 28 );
+    Iota()( v.data(), v.size() );
+    sw.stop();
+    sink = v[v.size() / 2];
+}
+
+/* The same buffer written once, through resize_and_overwrite */
+void vector_overwrite( Stopwatch &sw ) {
+    typedef NS::vector< int > vector_type;
+
+    sw.start();
+    vector_type v;
+#if NS_IS_FT
+    v.resize_and_overwrite( 1 << 28, Iota() );
+#else
+    v.resize( 1 << 28 );
+    Iota()( v.data(), v.size() );
+#endif
+    sw.stop();
+    sink = v[v.size() / 2];
+}
+
+/* Holds for Percent keys, or elements, in a hundred */
+template < int Percent > struct Below {
+    bool operator()( int x ) const { return x % 100 < Percent; }
+    template < typename K, typename V >
+    bool operator()( const NS::pair< K, V > &p ) const {
+        return ( *this )( p.first );
+    }
+};
+
+template < int Percent > void vector_erase_if( Stopwatch &sw ) {
+    typedef NS::vector< int > vector_type;
+
+    vector_type v;
+    for ( int i = 0; i < 10000000; i++ ) {
+        v.push_back( i * 7919L % 10000000 );
+    }
+
+    sw.start();
+#if NS_IS_FT
+    ft::erase_if( v, Below< Percent >() );
+#else
+    v.erase( std::remove_if( v.begin(), v.end(), Below< Percent >() ),
+             v.end() );
+#endif
+    sw.stop();
+    sink = v.size();
+}
+
+/* 4M ints scanned 50 times, all equal but the last one */
+struct Scan {
+    typedef NS::vector< int, ALIGNED_ALLOCATOR< int > > vector_type;
+
+    vector_type a;
+    vector_type b;
+
+    Scan() : a( 4000000, 7 ), b( a ) { b.back() = 8; }
+};
+
+void vector_equal( Stopwatch &sw ) {
+    Scan s;
+    long n = 0;
+
+    sw.start();
+    for ( int i = 0; i < 50; i++ ) {
+        s.b.back() = 8 + i;
+        n += s.a == s.b;
+    }
+    sw.stop();
+    sink = n;
+}
+
+void vector_less( Stopwatch &sw ) {
+    Scan s;
+    long n = 0;
+
+    sw.start();
+    for ( int i = 0; i < 50; i++ ) {
+        s.b.back() = 8 + i;
+        n += s.a < s.b;
+    }
+    sw.stop();
+    sink = n;
+}
+
+void vector_find( Stopwatch &sw ) {
+    Scan s;
+    long n = 0;
+
+    sw.start();
+    for ( int i = 0; i < 50; i++ ) {
+        n += NS::find( s.b.begin(), s.b.end(), 8 ) - s.b.begin();
+    }
+    sw.stop();
+    sink = n;
+}
+
+void vector_count( Stopwatch &sw ) {
+    Scan s;
+    long n = 0;
+
+    sw.start();
+    for ( int i = 0; i < 50; i++ ) {
+        n += NS::count( s.b.begin(), s.b.end(), 7 );
+    }
+    sw.stop();
+    sink = n;
+}
+
+void vector_min_max( Stopwatch &sw ) {
+    Scan s;
+    long n = 0;
+
+    sw.start();
+    for ( int i = 0; i < 25; i++ ) {
+        n += *NS::min_element( s.b.begin(), s.b.end() );
+        n += *NS::max_element( s.b.begin(), s.b.end() );
+    }
+    sw.stop();
+    sink = n;
+}
+
+void vector_fill( Stopwatch &sw ) {
+    Scan s;
+
+    sw.start();
+    for ( int i = 0; i < 50; i++ ) { NS::fill( s.a.begin(), s.a.end(), i ); }
+    sw.stop();
+    sink = s.a[0];
+}
+
+/* std::vector stands in for every policy in the std build */
+template < typename Growth > struct growth_vector {
+#if NS_IS_FT
+    typedef ft::vector< int, std::allocator< int >, Growth > type;
+#else
+    typedef std::vector< int > type;
+#endif
+};
+
+template < typename Growth > void vector_growth( Stopwatch &sw ) {
+    typename growth_vector< Growth >::type v;
+
+    sw.start();
+    for ( int i = 0; i < 50000000; i++ ) { v.push_back( i ); }
+    sw.stop();
+    sink = v.capacity();
+}
+
+template < typename Growth > void vector_short_growth( Stopwatch &sw ) {
+    long sum = 0;
+
+    sw.start();
+    for ( int i = 0; i < 1000000; i++ ) {
+        typename growth_vector< Growth >::type v;
+        for ( int j = 0; j < 100; j++ ) { v.push_back( j ); }
+        sum += v.capacity();
+    }
+    sw.stop();
+    sink = sum;
+}
+
+void vector_mremap_growth( Stopwatch &sw ) {
+    typedef NS::vector< int, MMAP_ALLOCATOR< int > > vector_type;
+
+    vector_type v;
+
+    sw.start();
+    for ( int i = 0; i < 200000000; i++ ) { v.push_back( i ); }
+    sw.stop();
+    sink = v.capacity();
+}
+
+void small_vector_scratch( Stopwatch &sw ) {
+    typedef SMALL_VECTOR( int, 8 ) vector_type;
+
+    long sum = 0;
+
+    sw.start();
+    for ( int i = 0; i < 5000000; i++ ) {
+        vector_type v;
+        for ( int j = 0; j < 6; j++ ) { v.push_back( i + j ); }
+        sum += v[i % 6];
+    }
+    sw.stop();
+    sink = sum;
+}
+
+void small_stack_scratch( Stopwatch &sw ) {
+    typedef NS::stack< int, SMALL_VECTOR( int, 8 ) > stack_type;
+
+    long sum = 0;
+
+    sw.start();
+    for ( int i = 0; i < 5000000; i++ ) {
+        stack_type s;
+        for ( int j = 0; j < 5; j++ ) { s.push( i ^ j ); }
+        while ( !s.empty() ) {
+            sum += s.top();
+            s.pop();
+        }
+    }
+    sw.stop();
+    sink = sum;
+}
+
+void stack_push( Stopwatch &sw ) {
+    NS::stack< int > s;
+
+    sw.start();
+    for ( int i = 0; i < 50000000; i++ ) { s.push( i ); }
+    while ( !s.empty() ) { s.pop(); }
+    sw.stop();
+}
+
+void stack_vector_push( Stopwatch &sw ) {
+    NS::stack< int, NS::vector< int > > s;
+
+    sw.start();
+    for ( int i = 0; i < 50000000; i++ ) { s.push( i ); }
+    while ( !s.empty() ) { s.pop(); }
+    sw.stop();
+}
+
+static double monotonic() {
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * Times every push on its own and reports the latency below which Permille
+ * thousandths of them fall, 1000 being the worst one. A deque allocates a
+ * block now and then, a vector copies all it holds each time it doubles.
+ */
+template < typename Container, int Permille >
+void stack_push_latency( Stopwatch &sw ) {
+    const std::size_t           n = 4000000;
+    std::vector< double >       latency( n );
+    NS::stack< int, Container > s;
+
+    sw.start();
+    for ( std::size_t i = 0; i < n; i++ ) {
+        double start = monotonic();
+        s.push( int( i ) );
+        latency[i] = monotonic() - start;
+    }
+    sw.stop();
+
+    std::size_t k = std::min( n - 1, n * Permille / 1000 );
+    std::nth_element( latency.begin(), latency.begin() + k, latency.end() );
+    sw.report( latency[k] );
+}
+
+/* 1M queued keys, then 10M pushes of random keys and pops, about as many */
+template < typename Queue > void priority_queue_mixed( Stopwatch &sw ) {
+    typedef typename Queue::value_type key_type;
+
+    Queue    q;
+    unsigned x = 42;
+
+    for ( int i = 0; i < 1000000; i++ ) {
+        x = x * 1664525 + 1013904223;
+        q.push( key_type( x >> 8 ) );
+    }
+    sw.start();
+    for ( int i = 0; i < 10000000; i++ ) {
+        x = x * 1664525 + 1013904223;
+        if ( x >> 31 ) {
+            q.push( key_type( x >> 8 ) );
+        } else {
+            q.pop();
+        }
+    }
+    sw.stop();
+    sink = q.size();
+}
+
+/*
+ * A scheduler's queue, earliest deadline on top: each of 5M rounds pops
+ * one and schedules it again a random delay later, 1M stay queued.
+ */
+template < std::size_t Arity > void priority_queue_hold( Stopwatch &sw ) {
+    typedef PRIORITY_QUEUE( long, std::greater< long >, Arity ) queue_type;
+
+    queue_type q;
+    unsigned   x = 42;
+
+    for ( int i = 0; i < 1000000; i++ ) {
+        x = x * 1664525 + 1013904223;
+        q.push( x >> 12 );
+    }
+    sw.start();
+    for ( int i = 0; i < 5000000; i++ ) {
+        x      = x * 1664525 + 1013904223;
+        long t = q.top();
+        q.pop();
+        q.push( t + ( x >> 12 ) );
+    }
+    sw.stop();
+    sink = q.top();
+}
+
+/* 10M keys onto 1M queued ones, one push_range against std's pushes */
+void priority_queue_push_range( Stopwatch &sw ) {
+    typedef PRIORITY_QUEUE( int, std::less< int >, 4 ) queue_type;
+
+    NS::vector< int > keys( 10000000 );
+    queue_type        q;
+    unsigned          x = 42;
+
+    for ( std::size_t i = 0; i < keys.size(); i++ ) {
+        x       = x * 1664525 + 1013904223;
+        keys[i] = int( x >> 8 );
+        if ( i < 1000000 ) { q.push( keys[i] ); }
+    }
+    sw.start();
+#if NS_IS_FT
+    q.push_range( keys.begin(), keys.end() );
+#else
+    for ( std::size_t i = 0; i < keys.size(); i++ ) { q.push( keys[i] ); }
+#endif
+    sw.stop();
+    sink = q.top();
+}
+
+/*
+ * A synthetic road network: a 1024 x 1024 grid of junctions joined by
+ * streets 10 to 100 long, every 32nd row and column a highway eight times
+ * faster. Edges are laid out by source, the targets of u from offset[u].
+ */
+struct Road_network {
+    NS::vector< int > offset;
+    NS::vector< int > target;
+    NS::vector< int > length;
+
+    explicit Road_network( int w ) {
+        unsigned x = 42;
+
+        offset.reserve( w * w + 1 );
+        for ( int u = 0; u < w * w; u++ ) {
+            int ux = u % w;
+            int uy = u / w;
+            int next[] = { ux ? u - 1 : -1,
+                           ux + 1 < w ? u + 1 : -1,
+                           uy ? u - w : -1,
+                           uy + 1 < w ? u + w : -1 };
+
+            offset.push_back( int( target.size() ) );
+            for ( int i = 0; i < 4; i++ ) {
+                if ( next[i] < 0 ) { continue; }
+                x       = x * 1664525 + 1013904223;
+                int len = 10 + int( ( x >> 8 ) % 91 );
+                bool highway = i < 2 ? uy % 32 == 0 : ux % 32 == 0;
+                target.push_back( next[i] );
+                length.push_back( highway ? len / 8 + 1 : len );
+            }
+        }
+        offset.push_back( int( target.size() ) );
+    }
+
+    int size() const { return int( offset.size() ) - 1; }
+};
+
+/* Shortest paths from a corner, queue entries keyed by distance */
+typedef NS::pair< long, int > road_entry;
+
+/* The usual lazy queue: a push per shorter path, stale entries skipped */
+template < typename Queue >
+void road_dijkstra_lazy( Stopwatch &sw, const Road_network &g ) {
+    NS::vector< long > dist( g.size(), -1 );
+    NS::vector< char > done( g.size(), 0 );
+    Queue              q;
+
+    sw.start();
+    dist[0] = 0;
+    q.push( road_entry( 0, 0 ) );
+    while ( !q.empty() ) {
+        road_entry e = q.top();
+        q.pop();
+        if ( done[e.second] ) { continue; }
+        done[e.second] = 1;
+        for ( int i = g.offset[e.second]; i < g.offset[e.second + 1]; i++ ) {
+            int  v = g.target[i];
+            long d = e.first + g.length[i];
+            if ( dist[v] < 0 || d < dist[v] ) {
+                dist[v] = d;
+                q.push( road_entry( d, v ) );
+            }
+        }
+    }
+    sw.stop();
+    sink = dist.back();
+}
+
+/*
+ * One entry per junction, moved by decrease_key when a shorter path turns
+ * up. std has no addressable heap: its build runs the lazy queue.
+ */
+void road_dijkstra( Stopwatch &sw ) {
+    Road_network g( 1024 );
+
+#if NS_IS_FT
+    typedef ft::pairing_heap< road_entry, std::greater< road_entry > >
+        heap_type;
+
+    NS::vector< long >                   dist( g.size(), -1 );
+    NS::vector< char >                   done( g.size(), 0 );
+    NS::vector< heap_type::handle_type > handle( g.size() );
+    heap_type                            heap;
+
+    sw.start();
+    dist[0]   = 0;
+    handle[0] = heap.push( road_entry( 0, 0 ) );
+    while ( !heap.empty() ) {
+        road_entry e = heap.top();
+        heap.pop();
+        done[e.second] = 1;
+        for ( int i = g.offset[e.second]; i < g.offset[e.second + 1]; i++ ) {
+            int  v = g.target[i];
+            long d = e.first + g.length[i];
+            if ( dist[v] < 0 ) {
+                dist[v]   = d;
+                handle[v] = heap.push( road_entry( d, v ) );
+            } else if ( !done[v] && d < dist[v] ) {
+                dist[v] = d;
+                heap.decrease_key( handle[v], road_entry( d, v ) );
+            }
+        }
+    }
+    sw.stop();
+    sink = dist.back();
+#else
+    road_dijkstra_lazy< std::priority_queue< road_entry,
+                                             std::vector< road_entry >,
+                                             std::greater< road_entry > > >(
+        sw, g );
+#endif
+}
+
+/* The lazy queue in both builds, over NS::priority_queue */
+void road_dijkstra_priority_queue( Stopwatch &sw ) {
+    road_dijkstra_lazy< NS::priority_queue< road_entry,
+                                            NS::vector< road_entry >,
+                                            std::greater< road_entry > > >(
+        sw, Road_network( 1024 ) );
+}
+
+void map_subscript( Stopwatch &sw ) {
+    typedef NS::map< key_type,
+                     mapped_type,
+                     std::less< key_type >,
+                     Vallocator< value_type > >
+        map_type;
+
+    map_type      m;
+    mapped_type   x = F< mapped_type >()();
+    F< key_type > h;
+
+    sw.start();
+    for ( map_type::size_type i( 0 ); i < 1000000; i++ ) { m[h()] = x; }
+    sw.stop();
+}
+
+void map_subscript_hit( Stopwatch &sw ) {
+    typedef NS::map< key_type,
+                     mapped_type,
+                     std::less< key_type >,
+                     Vallocator< value_type > >
+        map_type;
+
+    map_type      m;
+    mapped_type   x = F< mapped_type >()();
+    F< key_type > h;
+    key_type      keys[1000];
+
+    for ( std::size_t i( 0 ); i < 1000; i++ ) { keys[i] = h(); }
+    for ( std::size_t i( 0 ); i < 1000; i++ ) { m[keys[i]] = x; }
+
+    sw.start();
+    for ( std::size_t i( 0 ); i < 2000000; i++ ) { m[keys[i % 1000]] = x; }
+    sw.stop();
+}
+
+void set_insert( Stopwatch &sw ) {
+    typedef NS::
+        set< mapped_type, std::less< mapped_type >, Vallocator< mapped_type > >
+            set_type;
+
+    set_type         s;
+    F< mapped_type > h;
+
+    sw.start();
+    for ( set_type::size_type i( 0 ); i < 1000000; i++ ) { s.insert( h() ); }
+    sw.stop();
+}
+
+void map_churn( Stopwatch &sw ) {
+    typedef NS::map< int,
+                     int,
+                     std::less< int >,
+                     POOL_ALLOCATOR< NS::pair< const int, int > > >
+        map_type;
+
+    map_type m;
+    for ( int i = 0; i < 100000; i++ ) { m[i] = i; }
+    std::srand( 42 );
+
+    sw.start();
+    for ( int i = 0; i < 2000000; i++ ) {
+        m.erase( std::rand() % 200000 );
+        m[std::rand() % 200000] = i;
+    }
+    sw.stop();
+}
+
+void map_bounds( Stopwatch &sw ) {
+    typedef NS::map< int, int > map_type;
+
+    map_type m;
+    for ( int i = 0; i < 10000000; i++ ) {
+        m.insert( m.end(), NS::make_pair( i * 2, i ) );
+    }
+    std::srand( 42 );
+
+    long sum = 0;
+    sw.start();
+    for ( int i = 0; i < 1000000; i++ ) {
+        int k = std::rand() % 19999998;
+
+        NS::pair< map_type::iterator, map_type::iterator > range
+            = m.equal_range( k );
+
+        sum += m.lower_bound( k )->second;
+        sum += ( --m.upper_bound( k ) )->second;
+        sum += std::distance( range.first, range.second );
+    }
+    sw.stop();
+    if ( !sum ) { std::cerr << sum << std::endl; }
+}
+
+void map_copy( Stopwatch &sw ) {
+    typedef NS::map< int, int > map_type;
+
+    map_type m;
+    map_type other;
+    std::srand( 42 );
+    for ( int i = 0; i < 2000000; i++ ) {
+        m[std::rand()]     = i;
+        other[std::rand()] = i;
+    }
+
+    sw.start();
+    map_type copy( m );
+    other = m;
+    sw.stop();
+}
+
+void map_clear( Stopwatch &sw ) {
+    typedef NS::map< int, int > map_type;
+
+    map_type *m = new map_type;
+    map_type  other;
+    for ( int i = 0; i < 2000000; i++ ) {
+        ( *m )[i] = i;
+        other[i]  = i;
+    }
+
+    sw.start();
+    other.clear();
+    delete m;
+    sw.stop();
+}
+
+template < int Percent > void map_erase_if( Stopwatch &sw ) {
+    typedef NS::map< int, int > map_type;
+
+    map_type m;
+    for ( int i = 0; i < 1000000; i++ ) { m[i * 7919L % 1000000] = i; }
+
+    sw.start();
+#if NS_IS_FT
+    ft::erase_if( m, Below< Percent >() );
+#else
+    for ( map_type::iterator it = m.begin(); it != m.end(); ) {
+        if ( Below< Percent >()( *it ) ) {
+            m.erase( it++ );
+        } else {
+            it++;
+        }
+    }
+#endif
+    sw.stop();
+    sink = m.size();
+}
+
+void map_sorted_build( Stopwatch &sw ) {
+    typedef NS::map< int, int > map_type;
+
+    std::vector< NS::pair< int, int > > v;
+    for ( int i = 0; i < 2000000; i++ ) { v.push_back( NS::make_pair( i, i ) ); }
+
+    sw.start();
+    map_type m( v.begin(), v.end() );
+    sw.stop();
+}
+
+void set_sorted_build( Stopwatch &sw ) {
+    typedef NS::set< int > set_type;
+
+    std::vector< int > v;
+    for ( int i = 0; i < 2000000; i++ ) { v.push_back( i ); }
+
+    sw.start();
+    set_type s( v.begin(), v.end() );
+    sw.stop();
+}
+
+void map_append( Stopwatch &sw ) {
+    typedef NS::map< int, int > map_type;
+
+    map_type m;
+
+    sw.start();
+    for ( int i = 0; i < 5000000; i++ ) {
+        m.insert( m.end(), NS::make_pair( i, i ) );
+    }
+    sw.stop();
+}
+
+void set_string_insert( Stopwatch &sw ) {
+    typedef NS::set< std::string > set_type;
+
+    std::vector< std::string > v;
+    std::srand( 42 );
+    for ( int i = 0; i < 1000000; i++ ) {
+        std::ostringstream ss;
+        ss << "key-" << std::rand() << "-" << i;
+        v.push_back( ss.str() );
+    }
+
+    sw.start();
+    set_type s;
+    for ( std::size_t i = 0; i < v.size(); i++ ) { s.insert( v[i] ); }
+    set_type copy( s );
+    sw.stop();
+}
+
+/* -------------------------------- Parallel -------------------------------- */
+
+#ifndef BENCH_PARALLEL_SIZE
+#define BENCH_PARALLEL_SIZE 100000000
+#endif
+
+/*
+ * ft::parallel on a pool of Threads against the sequential std algorithm,
+ * so the ratio falls as threads are added. Only `make bench_parallel` runs
+ * them, they take minutes.
+ */
+struct Batch {
+    NS::vector< int > v;
+
+    Batch() : v( BENCH_PARALLEL_SIZE ) {
+        unsigned x = 42;
+        for ( std::size_t i = 0; i < v.size(); i++ ) {
+            x    = x * 1664525 + 1013904223;
+            v[i] = int( x >> 8 );
+        }
+    }
+};
+
+struct Bump {
+    void operator()( int &x ) const { x++; }
+};
+
+struct Scale {
+    int operator()( int x ) const { return x * 3 + 1; }
+};
+
+template < int Threads > void parallel_for_each( Stopwatch &sw ) {
+    Batch b;
+#if NS_IS_FT
+    ft::parallel::thread_pool pool( Threads );
+#endif
+
+    sw.start();
+#if NS_IS_FT
+    ft::parallel::for_each( pool, b.v.begin(), b.v.end(), Bump() );
+#else
+    std::for_each( b.v.begin(), b.v.end(), Bump() );
+#endif
+    sw.stop();
+    sink = b.v[0];
+}
+
+template < int Threads > void parallel_transform( Stopwatch &sw ) {
+    Batch             b;
+    NS::vector< int > out( b.v.size() );
+#if NS_IS_FT
+    ft::parallel::thread_pool pool( Threads );
+#endif
+
+    sw.start();
+#if NS_IS_FT
+    ft::parallel::transform( pool,
+                             b.v.begin(),
+                             b.v.end(),
+                             out.begin(),
+                             Scale() );
+#else
+    std::transform( b.v.begin(), b.v.end(), out.begin(), Scale() );
+#endif
+    sw.stop();
+    sink = out[0];
+}
+
+template < int Threads > void parallel_reduce( Stopwatch &sw ) {
+    Batch b;
+    long  sum;
+#if NS_IS_FT
+    ft::parallel::thread_pool pool( Threads );
+#endif
+
+    sw.start();
+#if NS_IS_FT
+    sum = ft::parallel::reduce( pool,
+                                b.v.begin(),
+                                b.v.end(),
+                                0L,
+                                std::plus< long >() );
+#else
+    sum = std::accumulate( b.v.begin(), b.v.end(), 0L, std::plus< long >() );
+#endif
+    sw.stop();
+    sink = sum;
+}
+
+template < int Threads > void parallel_sort( Stopwatch &sw ) {
+    Batch b;
+#if NS_IS_FT
+    ft::parallel::thread_pool pool( Threads );
+#endif
+
+    sw.start();
+#if NS_IS_FT
+    ft::parallel::sort( pool, b.v.begin(), b.v.end() );
+#else
+    std::sort( b.v.begin(), b.v.end() );
+#endif
+    sw.stop();
+    sink = b.v[b.v.size() / 2];
+}
+
+template < int Threads > void parallel_uninitialized_copy( Stopwatch &sw ) {
+    Batch                 b;
+    std::allocator< int > alloc;
+    int                  *p = alloc.allocate( b.v.size() );
+#if NS_IS_FT
+    ft::parallel::thread_pool pool( Threads );
+#endif
+
+    sw.start();
+#if NS_IS_FT
+    ft::parallel::uninitialized_copy( pool, b.v.begin(), b.v.end(), p );
+#else
+    std::uninitialized_copy( b.v.begin(), b.v.end(), p );
+#endif
+    sw.stop();
+    sink = p[0];
+    alloc.deallocate( p, b.v.size() );
+}
+
+/* ---------------------------------- Ring ---------------------------------- */
+
+/*
+ * A producer thread hands values to the consumer, the calling thread, both
+ * pinned to CPUs of their own when there are two. SPSC_RING is the mutex
+ * and deque std builds stand for. Sides yield when the ring is full or
+ * empty, so a single CPU still gets through.
+ */
+static void pin( pthread_t thread, int cpu ) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    CPU_SET( cpu % sysconf( _SC_NPROCESSORS_ONLN ), &set );
+    pthread_setaffinity_np( thread, sizeof( set ), &set );
+#else
+    ( void )thread;
+    ( void )cpu;
+#endif
+}
+
+typedef SPSC_RING( long )   long_ring;
+typedef SPSC_RING( double ) stamp_ring;
+
+/* Pushes 0 to n - 1, Batch at a time */
+template < std::size_t Batch > struct Ring_producer {
+    long_ring &ring;
+    long       n;
+
+    static void *run( void *p ) {
+        Ring_producer &self = *static_cast< Ring_producer * >( p );
+        long           values[Batch];
+
+        pin( pthread_self(), 1 );
+        for ( long i = 0; i < self.n; ) {
+            std::size_t k = std::min< long >( Batch, self.n - i );
+            for ( std::size_t j = 0; j < k; j++ ) { values[j] = i + long( j ); }
+            std::size_t pushed = Batch == 1 ? self.ring.try_push( values[0] )
+                                            : self.ring.try_push_n( values, k );
+            if ( !pushed ) { sched_yield(); }
+            i += long( pushed );
+        }
+        return 0;
+    }
+};
+
+/* 20M longs through a ring of 4096, Batch a call on either side */
+template < std::size_t Batch > void ring_throughput( Stopwatch &sw ) {
+    const long             n = 20000000;
+    long_ring              ring( 4096 );
+    Ring_producer< Batch > producer = { ring, n };
+    long                   values[Batch];
+    long                   sum = 0;
+    pthread_t              thread;
+
+    pin( pthread_self(), 0 );
+    sw.start();
+    pthread_create( &thread, 0, Ring_producer< Batch >::run, &producer );
+    for ( long got = 0; got < n; ) {
+        std::size_t k = Batch == 1 ? ring.try_pop( values[0] )
+                                   : ring.try_pop_n( values, Batch );
+        if ( !k ) { sched_yield(); }
+        for ( std::size_t j = 0; j < k; j++ ) { sum += values[j]; }
+        got += long( k );
+    }
+    pthread_join( thread, 0 );
+    sw.stop();
+    sink = sum;
+}
+
+/* Pushes n timestamps, each once the last one is gone */
+struct Stamp_producer {
+    stamp_ring &ring;
+    long        n;
+
+    static void *run( void *p ) {
+        Stamp_producer &self = *static_cast< Stamp_producer * >( p );
+
+        pin( pthread_self(), 1 );
+        for ( long i = 0; i < self.n; i++ ) {
+            while ( !self.ring.empty() ) { sched_yield(); }
+            self.ring.try_push( monotonic() );
+        }
+        return 0;
+    }
+};
+
+/*
+ * Times 200k lone handoffs, from the push to the consumer's pop, and
+ * reports the one below which Permille thousandths of them fall.
+ */
+template < int Permille > void ring_latency( Stopwatch &sw ) {
+    const long            n = 200000;
+    stamp_ring            ring( 64 );
+    Stamp_producer        producer = { ring, n };
+    std::vector< double > latency( n );
+    pthread_t             thread;
+
+    pin( pthread_self(), 0 );
+    sw.start();
+    pthread_create( &thread, 0, Stamp_producer::run, &producer );
+    for ( long i = 0; i < n; ) {
+        double stamp;
+        if ( ring.try_pop( stamp ) ) {
+            latency[i++] = monotonic() - stamp;
+        } else {
+            sched_yield();
+        }
+    }
+    pthread_join( thread, 0 );
+    sw.stop();
+
+    std::size_t k = std::min< std::size_t >( n - 1, n * Permille / 1000 );
+    std::nth_element( latency.begin(), latency.begin() + k, latency.end() );
+    sw.report( latency[k] );
+}
+
+/*
+ * Threads share a stack like a free list: each pushes and pops in turn,
+ * 16M pairs between them all. The lock-free ft::concurrent_stack against
+ * std::stack behind a mutex, and locked_stack_* runs NS::stack behind the
+ * same mutex.
+ */
+template < typename Stack > struct Churn {
+    Stack    *stack;
+    long      n;
+    long      sum;
+    pthread_t thread;
+
+    static void *run( void *p ) {
+        Churn &self = *static_cast< Churn * >( p );
+        long   sum  = 0;
+        int    x    = 0;
+        for ( long i = 0; i < self.n; i++ ) {
+            self.stack->push( int( i ) );
+            if ( self.stack->pop( x ) ) { sum += x; }
+        }
+        self.sum = sum;
+        return 0;
+    }
+};
+
+template < typename Stack, int Threads > void stack_churn( Stopwatch &sw ) {
+    Stack          stack;
+    Churn< Stack > churn[Threads];
+
+    for ( int i = 0; i < 1024; i++ ) { stack.push( i ); }
+    sw.start();
+    for ( int i = 0; i < Threads; i++ ) {
+        churn[i].stack = &stack;
+        churn[i].n     = 16000000 / Threads;
+        pthread_create( &churn[i].thread, 0, Churn< Stack >::run, &churn[i] );
+    }
+    for ( int i = 0; i < Threads; i++ ) {
+        pthread_join( churn[i].thread, 0 );
+        sink = sink + churn[i].sum;
+    }
+    sw.stop();
+}
+
+typedef CONCURRENT_STACK( int ) concurrent_int_stack;
+typedef Locked_stack< int, NS::stack< int > > locked_int_stack;
+
+struct Scenario {
+    const char *name;
+    void ( *run )( Stopwatch & );
+};
+
+#ifndef BENCH_PARALLEL
+const Scenario scenarios[] = {
+    { "vector_push_back", vector_push_back },
+    { "vector_middle_insert", vector_middle_insert },
+    { "vector_middle_erase", vector_middle_erase },
+    { "vector_pod_erase", vector_pod_erase },
+    { "vector_stream_insert", vector_stream_insert },
+    { "vector_overwrite_value_init", vector_overwrite_value_init },
+    { "vector_overwrite", vector_overwrite },
+    { "vector_erase_if_1", vector_erase_if< 1 > },
+    { "vector_erase_if_50", vector_erase_if< 50 > },
+    { "vector_erase_if_99", vector_erase_if< 99 > },
+    { "vector_equal", vector_equal },
+    { "vector_less", vector_less },
+    { "vector_find", vector_find },
+    { "vector_count", vector_count },
+    { "vector_min_max", vector_min_max },
+    { "vector_fill", vector_fill },
+    { "vector_growth_double", vector_growth< ft::growth_double > },
+    { "vector_growth_one_and_half",
+      vector_growth< ft::growth_one_and_half > },
+    { "vector_growth_chunk", vector_growth< ft::growth_chunk< 1 << 20 > > },
+    { "vector_growth_size_class", vector_growth< ft::growth_size_class<> > },
+    { "vector_short_growth_double", vector_short_growth< ft::growth_double > },
+    { "vector_short_growth_size_class",
+      vector_short_growth< ft::growth_size_class<> > },
+    { "vector_mremap_growth", vector_mremap_growth },
+    { "small_vector_scratch", small_vector_scratch },
+    { "small_stack_scratch", small_stack_scratch },
+    { "stack_push", stack_push },
+    { "stack_vector_push", stack_vector_push },
+    { "stack_push_p50", stack_push_latency< NS::deque< int >, 500 > },
+    { "stack_push_p99", stack_push_latency< NS::deque< int >, 990 > },
+    { "stack_push_p999", stack_push_latency< NS::deque< int >, 999 > },
+    { "stack_push_max", stack_push_latency< NS::deque< int >, 1000 > },
+    { "stack_vector_push_p50", stack_push_latency< NS::vector< int >, 500 > },
+    { "stack_vector_push_p99", stack_push_latency< NS::vector< int >, 990 > },
+    { "stack_vector_push_p999",
+      stack_push_latency< NS::vector< int >, 999 > },
+    { "stack_vector_push_max",
+      stack_push_latency< NS::vector< int >, 1000 > },
+    { "priority_queue_mixed_2",
+      priority_queue_mixed< PRIORITY_QUEUE( int, std::less< int >, 2 ) > },
+    { "priority_queue_mixed_4",
+      priority_queue_mixed< PRIORITY_QUEUE( int, std::less< int >, 4 ) > },
+    { "priority_queue_mixed_8",
+      priority_queue_mixed< PRIORITY_QUEUE( int, std::less< int >, 8 ) > },
+    { "priority_queue_mixed_object",
+      priority_queue_mixed<
+          PRIORITY_QUEUE( mapped_type, std::less< mapped_type >, 4 ) > },
+    { "priority_queue_hold_2", priority_queue_hold< 2 > },
+    { "priority_queue_hold_4", priority_queue_hold< 4 > },
+    { "priority_queue_hold_8", priority_queue_hold< 8 > },
+    { "priority_queue_push_range", priority_queue_push_range },
+    { "road_dijkstra", road_dijkstra },
+    { "road_dijkstra_priority_queue", road_dijkstra_priority_queue },
+    { "map_subscript", map_subscript },
+    { "map_subscript_hit", map_subscript_hit },
+    { "set_insert", set_insert },
+    { "map_churn", map_churn },
+    { "map_bounds", map_bounds },
+    { "map_copy", map_copy },
+    { "map_clear", map_clear },
+    { "map_erase_if_1", map_erase_if< 1 > },
+    { "map_erase_if_50", map_erase_if< 50 > },
+    { "map_erase_if_99", map_erase_if< 99 > },
+    { "map_sorted_build", map_sorted_build },
+    { "set_sorted_build", set_sorted_build },
+    { "map_append", map_append },
+    { "set_string_insert", set_string_insert },
+    { "ring_throughput_1", ring_throughput< 1 > },
+    { "ring_throughput_64", ring_throughput< 64 > },
+    { "ring_latency_p50", ring_latency< 500 > },
+    { "ring_latency_p99", ring_latency< 990 > },
+};
+#else
+/* `make bench_parallel` runs the scaling scenarios alone */
+const Scenario scenarios[] = {
+    { "parallel_for_each_1", parallel_for_each< 1 > },
+    { "parallel_for_each_2", parallel_for_each< 2 > },
+    { "parallel_for_each_4", parallel_for_each< 4 > },
+    { "parallel_for_each_8", parallel_for_each< 8 > },
+    { "parallel_for_each_16", parallel_for_each< 16 > },
+    { "parallel_transform_1", parallel_transform< 1 > },
+    { "parallel_transform_2", parallel_transform< 2 > },
+    { "parallel_transform_4", parallel_transform< 4 > },
+    { "parallel_transform_8", parallel_transform< 8 > },
+    { "parallel_transform_16", parallel_transform< 16 > },
+    { "parallel_reduce_1", parallel_reduce< 1 > },
+    { "parallel_reduce_2", parallel_reduce< 2 > },
+    { "parallel_reduce_4", parallel_reduce< 4 > },
+    { "parallel_reduce_8", parallel_reduce< 8 > },
+    { "parallel_reduce_16", parallel_reduce< 16 > },
+    { "parallel_sort_1", parallel_sort< 1 > },
+    { "parallel_sort_2", parallel_sort< 2 > },
+    { "parallel_sort_4", parallel_sort< 4 > },
+    { "parallel_sort_8", parallel_sort< 8 > },
+    { "parallel_sort_16", parallel_sort< 16 > },
+    { "parallel_uninitialized_copy_1", parallel_uninitialized_copy< 1 > },
+    { "parallel_uninitialized_copy_2", parallel_uninitialized_copy< 2 > },
+    { "parallel_uninitialized_copy_4", parallel_uninitialized_copy< 4 > },
+    { "parallel_uninitialized_copy_8", parallel_uninitialized_copy< 8 > },
+    { "parallel_uninitialized_copy_16", parallel_uninitialized_copy< 16 > },
+    { "concurrent_stack_1", stack_churn< concurrent_int_stack, 1 > },
+    { "concurrent_stack_2", stack_churn< concurrent_int_stack, 2 > },
+    { "concurrent_stack_4", stack_churn< concurrent_int_stack, 4 > },
+    { "concurrent_stack_8", stack_churn< concurrent_int_stack, 8 > },
+    { "concurrent_stack_16", stack_churn< concurrent_int_stack, 16 > },
+    { "locked_stack_1", stack_churn< locked_int_stack, 1 > },
+    { "locked_stack_2", stack_churn< locked_int_stack, 2 > },
+    { "locked_stack_4", stack_churn< locked_int_stack, 4 > },
+    { "locked_stack_8", stack_churn< locked_int_stack, 8 > },
+    { "locked_stack_16", stack_churn< locked_int_stack, 16 > },
+};
+#endif
+
+/* --------------------------------- Report --------------------------------- */
+
+struct Result {
+    double      seconds;
+    std::size_t allocations;
+    long        peak_rss;
+};
+
+Result best_of( const Scenario &scenario ) {
+    Result best = { 0, 0, 0 };
+    for ( int i = 0; i < BENCH_REPEAT; i++ ) {
+        Stopwatch sw;
+        scenario.run( sw );
+        if ( !i || sw.seconds() < best.seconds ) {
+            best.seconds     = sw.seconds();
+            best.allocations = sw.allocations();
+        }
+    }
+    return best;
+}
+
+/* In a child process, so the peak RSS (in KiB) is the scenario's own */
+Result run( const Scenario &scenario ) {
+    Result best = { 0, 0, 0 };
+    int    fds[2];
+    pid_t  pid;
+
+    std::cout.flush();
+    if ( pipe( fds ) == -1 ) { return best_of( scenario ); }
+    if ( ( pid = fork() ) == -1 ) {
+        close( fds[0] );
+        close( fds[1] );
+        return best_of( scenario );
+    }
+    if ( !pid ) {
+        struct rusage usage;
+
+        close( fds[0] );
+        best = best_of( scenario );
+        getrusage( RUSAGE_SELF, &usage );
+        best.peak_rss = usage.ru_maxrss;
+        _exit( write( fds[1], &best, sizeof( best ) ) != sizeof( best ) );
+    }
+    close( fds[1] );
+    if ( read( fds[0], &best, sizeof( best ) ) != sizeof( best ) ) {
+        std::cerr << scenario.name << ": died" << std::endl;
+    }
+    close( fds[0] );
+    waitpid( pid, 0, 0 );
+    return best;
+}
+
+std::map< std::string, Result > read_reference( const char *path ) {
+    std::map< std::string, Result > reference;
+    std::ifstream                   file( path );
+    std::string                     line;
+
+    std::getline( file, line );
+    while ( std::getline( file, line ) ) {
+        std::istringstream ss( line );
+        std::string        name;
+        std::string        seconds;
+        std::string        allocations;
+        std::string        peak_rss;
+
+        std::getline( ss, name, ',' );
+        std::getline( ss, seconds, ',' );
+        std::getline( ss, allocations, ',' );
+        std::getline( ss, peak_rss, ',' );
+        reference[name].seconds = std::strtod( seconds.c_str(), 0 );
+        reference[name].allocations
+            = std::strtoul( allocations.c_str(), 0, 10 );
+        reference[name].peak_rss = std::strtol( peak_rss.c_str(), 0, 10 );
+    }
+    return reference;
+}
+
+/*
+ * Without arguments, prints "scenario,seconds,allocations,peak_rss_kb"
+ * for NS.
+ * BENCH_NAME and BENCH_REFERENCE label the columns when comparing builds.
+ * Given the output of another build, prints both side by side with the
+ * ratio of our time over theirs, and fails when a ratio exceeds the
+ * optional maximum slowdown (in percent).
+ */
+int main( int ac, char **av ) {
+    const std::size_t n = sizeof( scenarios ) / sizeof( *scenarios );
+
+    if ( ac < 2 ) {
+        std::cout << "scenario,seconds,allocations,peak_rss_kb" << std::endl;
+        for ( std::size_t i = 0; i < n; i++ ) {
+            Result r = run( scenarios[i] );
+            std::cout << scenarios[i].name << "," << r.seconds << ","
+                      << r.allocations << "," << r.peak_rss << std::endl;
+        }
+        return 0;
+    }
+
+    std::map< std::string, Result > reference = read_reference( av[1] );
+    double max_ratio = ac > 2 ? 1 + std::strtod( av[2], 0 ) / 100 : 0;
+    int    status    = 0;
+    const std::string theirs( TOSTRING( BENCH_REFERENCE ) );
+    const std::string ours( TOSTRING( BENCH_NAME ) );
+
+    std::cout << "scenario," << theirs << "_seconds," << ours
+              << "_seconds,ratio," << theirs << "_allocations," << ours
+              << "_allocations," << theirs << "_peak_rss_kb," << ours
+              << "_peak_rss_kb" << std::endl;
+    for ( std::size_t i = 0; i < n; i++ ) {
+        Result r     = run( scenarios[i] );
+        Result ref   = reference[scenarios[i].name];
+        double ratio = ref.seconds ? r.seconds / ref.seconds : 0;
+
+        std::cout << scenarios[i].name << "," << ref.seconds << ","
+                  << r.seconds << "," << ratio << "," << ref.allocations << ","
+                  << r.allocations << "," << ref.peak_rss << ","
+                  << r.peak_rss << std::endl;
+        if ( max_ratio && ratio > max_ratio ) {
+            std::cerr << scenarios[i].name << ": " << ( ratio - 1 ) * 100
+                      << "% slower than " << theirs << std::endl;
+            status = 1;
+        }
+    }
+    return status;
+}
+
+#endif
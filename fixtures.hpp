@@ -0,0 +1,376 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <list>
+#include <new>
+#include <pthread.h>
+#include <set>
+#include <sstream>
+#include <stack>
+#include <utility>
+
+/* -------------------------------- Namespace ------------------------------- */
+
+/* `#if NS_IS_FT` guards ft-only code, std builds use the closest std type */
+#define NS_IS_( ns ) NS_IS_##ns
+#define NS_IS( ns ) NS_IS_( ns )
+#define NS_IS_ft 1
+#define NS_IS_FT NS_IS( NS )
+
+#if NS_IS_FT
+#define POOL_ALLOCATOR ft::pool_allocator
+#define MMAP_ALLOCATOR ft::mmap_allocator
+#define ALIGNED_ALLOCATOR ft::aligned_allocator
+#define SMALL_VECTOR( T, N ) ft::small_vector< T, N, Vallocator< T > >
+#define PRIORITY_QUEUE( T, Compare, D )                                       \
+    ft::priority_queue< T, ft::vector< T >, Compare, D >
+#define PAIRING_HEAP( T, Compare ) ft::pairing_heap< T, Compare >
+#define SPSC_RING( T ) ft::spsc_ring< T >
+#define CONCURRENT_STACK( T ) ft::concurrent_stack< T >
+#else
+#define POOL_ALLOCATOR std::allocator
+#define MMAP_ALLOCATOR std::allocator
+#define ALIGNED_ALLOCATOR std::allocator
+#define SMALL_VECTOR( T, N ) std::vector< T, Vallocator< T > >
+#define PRIORITY_QUEUE( T, Compare, D )                                       \
+    std::priority_queue< T, std::vector< T >, Compare >
+#define PAIRING_HEAP( T, Compare ) List_heap< T, Compare >
+#define SPSC_RING( T ) Locked_ring< T >
+#define CONCURRENT_STACK( T ) Locked_stack< T >
+#endif
+
+/* ---------------------------------- Data ---------------------------------- */
+
+template < typename T > class A {
+    T *_data;
+
+public:
+    typedef T value_type;
+
+    A( T val = T() ) : _data( new T( val ) ) {}
+    A( const A &other ) : _data( new T( *other._data ) ) {}
+    A &operator=( const A &other ) {
+        if ( _data ) {
+            *_data = *other._data;
+        } else {
+            _data = new T( *other._data );
+        }
+        return *this;
+    }
+#if __cplusplus >= 201103L
+    /* Leaves other empty, only fit to be destroyed or assigned to */
+    A( A &&other ) noexcept : _data( other._data ) { other._data = 0; }
+    A &operator=( A &&other ) noexcept {
+        std::swap( _data, other._data );
+        return *this;
+    }
+#endif
+    virtual ~A() { delete _data; }
+
+    T       &data() { return *_data; }
+    const T &data() const { return *_data; }
+
+    bool operator==( const A &other ) const { return *_data == *other._data; }
+    bool operator!=( const A &other ) const { return *_data != *other._data; }
+    bool operator<( const A &other ) const { return *_data < *other._data; }
+    bool operator>( const A &other ) const { return *_data > *other._data; }
+    bool operator<=( const A &other ) const { return *_data <= *other._data; }
+    bool operator>=( const A &other ) const { return *_data >= *other._data; }
+};
+
+/* --------------------------------- Functor -------------------------------- */
+
+template < typename T > struct F {
+    F() : _n( 0 ) {}
+    typename T::value_type operator()() {
+        _n++;
+        std::stringstream ss;
+        ss << _n;
+        typename T::value_type res;
+        ss >> res;
+        return res;
+    }
+
+private:
+    int _n;
+};
+
+/* ---------------------------- Custom allocator ---------------------------- */
+
+template < typename T > struct Vallocator;
+
+template <> struct Vallocator< void > {
+    typedef void              value_type;
+    typedef value_type       *pointer;
+    typedef const value_type *const_pointer;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+
+    template < class U > struct rebind {
+        typedef Vallocator< U > other;
+    };
+};
+
+template < typename T > struct Vallocator {
+    typedef T                 value_type;
+    typedef value_type       &reference;
+    typedef const value_type &const_reference;
+    typedef value_type       *pointer;
+    typedef const value_type *const_pointer;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+
+    template < typename U > struct rebind {
+        typedef Vallocator< U > other;
+    };
+
+    Vallocator() throw() {}
+    template < typename U > Vallocator( Vallocator< U > const & ) throw() {}
+
+    pointer allocate( const size_type &n,
+                      Vallocator< void >::const_pointer = 0 ) {
+        if ( n ) { _n_allocation++; }
+        _n_element += n;
+        return static_cast< pointer >(
+            ::operator new( n * sizeof( value_type ) ) );
+    }
+    void deallocate( pointer p, const size_type &n ) {
+        if ( n ) { _n_allocation--; }
+        _n_element -= n;
+        ::operator delete( p );
+    }
+    void construct( pointer p, value_type const &val ) {
+        _n_construction++;
+        ::new ( p ) value_type( val );
+    }
+#if __cplusplus >= 201103L
+    template < typename U, typename... Args >
+    void construct( U *p, Args &&...args ) {
+        _n_construction++;
+        ::new ( p ) U( std::forward< Args >( args )... );
+    }
+#endif
+    void destroy( pointer p ) {
+        if ( _n_construction ) { _n_construction--; }
+        p->~value_type();
+    }
+
+    size_type max_size() const throw() {
+        return std::numeric_limits< size_type >::max() / sizeof( value_type );
+    }
+    pointer       address( reference x ) const { return &x; }
+    const_pointer address( const_reference x ) const { return &x; }
+
+    static size_type get_n_allocation() { return _n_allocation; }
+    static size_type get_n_construction() { return _n_construction; }
+    /* Elements allocated and not yet handed back, as deallocate counts them */
+    static size_type get_n_element() { return _n_element; }
+
+private:
+    static size_type _n_allocation;
+    static size_type _n_construction;
+    static size_type _n_element;
+};
+
+template < typename T >
+typename Vallocator< T >::size_type Vallocator< T >::_n_allocation;
+template < typename T >
+typename Vallocator< T >::size_type Vallocator< T >::_n_construction;
+template < typename T >
+typename Vallocator< T >::size_type Vallocator< T >::_n_element;
+
+template < typename T, typename U >
+bool operator==( Vallocator< T > const &, Vallocator< U > const & ) {
+    return true;
+}
+template < typename T, typename U >
+bool operator!=( Vallocator< T > const &x, Vallocator< U > const &y ) {
+    return !( x == y );
+}
+
+/* ---------------------------- Addressable heap ---------------------------- */
+
+/*
+ * ft::pairing_heap's interface for std builds: values sit in a list, whose
+ * iterators are the handles, and a multiset orders them.
+ */
+template < typename T, typename Compare > class List_heap {
+    typedef typename std::list< T >::iterator _Iterator;
+
+    struct _By_value {
+        bool operator()( _Iterator a, _Iterator b ) const {
+            return Compare()( *a, *b );
+        }
+    };
+
+    typedef std::multiset< _Iterator, _By_value > _Order;
+
+    std::list< T > _values;
+    _Order         _order;
+
+    void _unlink( _Iterator h ) {
+        typename _Order::iterator it = _order.lower_bound( h );
+        while ( *it != h ) { it++; }
+        _order.erase( it );
+    }
+
+public:
+    typedef T         value_type;
+    typedef _Iterator handle_type;
+
+    List_heap() {}
+    List_heap( const List_heap &other ) { *this = other; }
+    List_heap &operator=( const List_heap &other ) {
+        _values.clear();
+        _order.clear();
+        for ( typename std::list< T >::const_iterator it
+              = other._values.begin();
+              it != other._values.end();
+              it++ ) {
+            push( *it );
+        }
+        return *this;
+    }
+
+    bool        empty() const { return _order.empty(); }
+    std::size_t size() const { return _order.size(); }
+    const T    &top() const { return **_order.rbegin(); }
+
+    handle_type push( const T &val ) {
+        _Iterator h = _values.insert( _values.end(), val );
+        _order.insert( h );
+        return h;
+    }
+    void pop() {
+        _Iterator h = *--_order.end();
+        _order.erase( --_order.end() );
+        _values.erase( h );
+    }
+    void update( handle_type h, const T &val ) {
+        _unlink( h );
+        *h = val;
+        _order.insert( h );
+    }
+    void decrease_key( handle_type h, const T &val ) { update( h, val ); }
+    void erase( handle_type h ) {
+        _unlink( h );
+        _values.erase( h );
+    }
+    void merge( List_heap &other ) {
+        _order.insert( other._order.begin(), other._order.end() );
+        other._order.clear();
+        _values.splice( _values.end(), other._values );
+    }
+};
+
+/* ------------------------------- Locked ring ------------------------------ */
+
+/*
+ * ft::spsc_ring's interface for std builds: a std::deque behind a mutex,
+ * bounded by the same power of two.
+ */
+template < typename T > class Locked_ring {
+    std::deque< T > _values;
+    std::size_t     _capacity;
+    pthread_mutex_t _mutex;
+
+    Locked_ring( const Locked_ring & );
+    Locked_ring &operator=( const Locked_ring & );
+
+public:
+    typedef T           value_type;
+    typedef std::size_t size_type;
+
+    explicit Locked_ring( size_type capacity ) : _capacity( 1 ) {
+        while ( _capacity < capacity ) { _capacity <<= 1; }
+        pthread_mutex_init( &_mutex, 0 );
+    }
+    ~Locked_ring() { pthread_mutex_destroy( &_mutex ); }
+
+    size_type capacity() const { return _capacity; }
+    size_type size() {
+        pthread_mutex_lock( &_mutex );
+        size_type n = _values.size();
+        pthread_mutex_unlock( &_mutex );
+        return n;
+    }
+    bool empty() { return !size(); }
+
+    bool try_push( const T &val ) { return try_push_n( &val, 1 ); }
+    bool try_pop( T &val ) { return try_pop_n( &val, 1 ); }
+
+    template < typename ForwardIterator >
+    size_type try_push_n( ForwardIterator first, size_type n ) {
+        pthread_mutex_lock( &_mutex );
+        n = std::min( n, _capacity - _values.size() );
+        for ( size_type i = 0; i < n; i++, first++ ) {
+            _values.push_back( *first );
+        }
+        pthread_mutex_unlock( &_mutex );
+        return n;
+    }
+
+    template < typename OutputIterator >
+    size_type try_pop_n( OutputIterator out, size_type n ) {
+        pthread_mutex_lock( &_mutex );
+        n = std::min( n, _values.size() );
+        std::copy( _values.begin(), _values.begin() + n, out );
+        _values.erase( _values.begin(), _values.begin() + n );
+        pthread_mutex_unlock( &_mutex );
+        return n;
+    }
+};
+
+/* ------------------------------ Locked stack ------------------------------ */
+
+/*
+ * ft::concurrent_stack's interface over any stack behind a mutex, what
+ * std builds use and what it is measured against.
+ */
+template < typename T, typename Stack = std::stack< T > > class Locked_stack {
+    Stack                   _values;
+    mutable pthread_mutex_t _mutex;
+
+    Locked_stack( const Locked_stack & );
+    Locked_stack &operator=( const Locked_stack & );
+
+public:
+    typedef T value_type;
+
+    Locked_stack() { pthread_mutex_init( &_mutex, 0 ); }
+    ~Locked_stack() { pthread_mutex_destroy( &_mutex ); }
+
+    bool empty() const {
+        pthread_mutex_lock( &_mutex );
+        bool empty = _values.empty();
+        pthread_mutex_unlock( &_mutex );
+        return empty;
+    }
+
+    void push( const T &val ) {
+        pthread_mutex_lock( &_mutex );
+        try {
+            _values.push( val );
+        } catch ( ... ) {
+            pthread_mutex_unlock( &_mutex );
+            throw;
+        }
+        pthread_mutex_unlock( &_mutex );
+    }
+
+    bool pop( T &val ) {
+        pthread_mutex_lock( &_mutex );
+        bool found = !_values.empty();
+        if ( found ) {
+            val = _values.top();
+            _values.pop();
+        }
+        pthread_mutex_unlock( &_mutex );
+        return found;
+    }
+};
+
+/* -------------------------------------------------------------------------- */
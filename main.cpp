@@ -1,178 +1,438 @@
 #ifdef NS
 
 #define VECTOR_TEST true
+#define DEQUE_TEST true
 #define STACK_TEST true
+#define PRIORITY_QUEUE_TEST true
+#define PAIRING_HEAP_TEST true
+#define SPSC_RING_TEST true
+#define CONCURRENT_STACK_TEST true
+#define PAIR_TEST true
 #define MAP_TEST true
 #define SET_TEST true
 
+#include "fixtures.hpp"
+#include "src/aligned_allocator.hpp"
+#include "src/concurrent_stack.hpp"
+#include "src/deque.hpp"
 #include "src/map.hpp"
+#include "src/pairing_heap.hpp"
+#include "src/parallel.hpp"
+#include "src/priority_queue.hpp"
 #include "src/set.hpp"
+#include "src/small_vector.hpp"
+#include "src/spsc_ring.hpp"
 #include "src/stack.hpp"
 #include "src/vector.hpp"
 
 #include <algorithm>
 #include <ciso646>
+#include <deque>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <map>
+#include <numeric>
+#include <queue>
+#include <sched.h>
 #include <set>
 #include <sstream>
 #include <stack>
+#include <stdexcept>
 #include <typeinfo>
 #include <vector>
+#if __cplusplus >= 201103L
+#include <type_traits>
+#endif
 
 #define STREAM std::cout << "#" << __LINE__ << "  "
 
-/* ---------------------------------- Data ---------------------------------- */
+/* ------------------------------- Algorithms ------------------------------- */
+
+namespace ft {
+
+template < typename T > T next( T it ) { return ++it; }
 
-template < typename T > class A {
-    T *_data;
+}
 
-public:
-    typedef T value_type;
+/* ------------------------------ Mutant stack ------------------------------ */
 
-    A( T val = T() ) : _data( new T( val ) ) {}
-    A( const A &other ) : _data( new T( *other._data ) ) {}
-    A &operator=( const A &other ) {
-        *_data = *other._data;
-        return *this;
+template < typename T, typename C > struct S : public NS::stack< T, C > {
+    typedef typename NS::stack< T, C >::container_type::const_iterator
+        const_iterator;
+    typedef typename NS::stack< T, C >::container_type::const_reverse_iterator
+        const_reverse_iterator;
+
+    S< T, C >() {}
+    S< T, C >( const S< T, C > &other ) : NS::stack< T, C >( other ) {}
+    S< T, C >( const NS::stack< T, C > &other ) : NS::stack< T, C >( other ) {}
+    S< T, C > &operator=( const S< T, C > &other ) {
+        NS::stack< T, C >::operator=( other );
     }
-    virtual ~A() { delete _data; }
 
-    T       &data() { return *_data; }
-    const T &data() const { return *_data; }
+    const_iterator         begin() const { return this->c.begin(); }
+    const_reverse_iterator rbegin() const { return this->c.rbegin(); }
+    const_iterator         end() const { return this->c.end(); }
+    const_reverse_iterator rend() const { return this->c.rend(); }
+};
+
+/* --------------------------------- Writer --------------------------------- */
 
-    bool operator==( const A &other ) const { return *_data == *other._data; }
-    bool operator!=( const A &other ) const { return *_data != *other._data; }
-    bool operator<( const A &other ) const { return *_data < *other._data; }
-    bool operator>( const A &other ) const { return *_data > *other._data; }
-    bool operator<=( const A &other ) const { return *_data <= *other._data; }
-    bool operator>=( const A &other ) const { return *_data >= *other._data; }
+/* Writes squares over a buffer, keeps half of them */
+struct Squares {
+    template < typename T >
+    std::size_t operator()( T *p, std::size_t n ) const {
+        for ( std::size_t i = 0; i < n; i++ ) { p[i] = T( i * i ); }
+        return n / 2;
+    }
 };
 
-/* --------------------------------- Functor -------------------------------- */
-
-template < typename T > struct F {
-    F() : _n( 0 ) {}
-    typename T::value_type operator()() {
-        _n++;
-        std::stringstream ss;
-        ss << _n;
-        typename T::value_type res;
-        ss >> res;
-        return res;
+/* -------------------------------- Predicate ------------------------------- */
+
+/* Holds for ints, A's and pair keys that are multiples of Period */
+template < int Period > struct Multiple {
+    bool operator()( int x ) const { return !( x % Period ); }
+    template < typename T > bool operator()( const A< T > &x ) const {
+        return ( *this )( x.data() );
+    }
+    template < typename K, typename V >
+    bool operator()( const NS::pair< K, V > &p ) const {
+        return ( *this )( p.first );
     }
+};
 
-private:
-    int _n;
+/* Holds for what Multiple< Period > does not */
+template < int Period > struct Apart {
+    template < typename T > bool operator()( const T &x ) const {
+        return !Multiple< Period >()( x );
+    }
 };
 
-/* ------------------------------- Algorithms ------------------------------- */
+/* ft::erase_if, or what it does to std containers */
+template < typename T, typename Alloc, typename Predicate >
+std::size_t erase_where( NS::vector< T, Alloc > &c, Predicate pred ) {
+#if NS_IS_FT
+    return ft::erase_if( c, pred );
+#else
+    std::size_t n = c.size();
+    c.erase( std::remove_if( c.begin(), c.end(), pred ), c.end() );
+    return n - c.size();
+#endif
+}
 
-namespace ft {
+template < typename T, typename Alloc, typename Predicate >
+std::size_t erase_where( NS::deque< T, Alloc > &c, Predicate pred ) {
+#if NS_IS_FT
+    return ft::erase_if( c, pred );
+#else
+    std::size_t n = c.size();
+    c.erase( std::remove_if( c.begin(), c.end(), pred ), c.end() );
+    return n - c.size();
+#endif
+}
 
-template < typename T > T next( T it ) { return ++it; }
+template < typename Container, typename Predicate >
+std::size_t erase_where( Container &c, Predicate pred ) {
+#if NS_IS_FT
+    return ft::erase_if( c, pred );
+#else
+    std::size_t n = c.size();
+    for ( typename Container::iterator it = c.begin(); it != c.end(); ) {
+        if ( pred( *it ) ) {
+            c.erase( it++ );
+        } else {
+            it++;
+        }
+    }
+    return n - c.size();
+#endif
+}
+
+/* ---------------------------------- Heap ---------------------------------- */
 
+/* Empties a copy of q, tops in the order they come */
+template < typename Queue > std::string popped( Queue q ) {
+    std::ostringstream os;
+    os << "{size: " << q.size() << ", data: [";
+    for ( bool first = true; !q.empty(); q.pop(), first = false ) {
+        if ( !first ) { os << ", "; }
+        os << q.top();
+    }
+    os << "]}";
+    return os.str();
 }
-/* ---------------------------- Custom allocator ---------------------------- */
 
-template < typename T > struct Vallocator;
+/* Shortest distances from the corner of a w by w grid, Dijkstra's way */
+template < typename Heap > NS::vector< int > grid_distances( int w ) {
+    typedef NS::pair< int, int > entry;
+
+    NS::vector< int >                        dist( w * w, -1 );
+    NS::vector< char >                       queued( w * w, 0 );
+    NS::vector< typename Heap::handle_type > handle( w * w );
+    Heap                                     heap;
+
+    dist[0]   = 0;
+    queued[0] = 1;
+    handle[0] = heap.push( entry( 0, 0 ) );
+    while ( !heap.empty() ) {
+        entry e = heap.top();
+        heap.pop();
+        queued[e.second] = 0;
+
+        int x = e.second % w;
+        int y = e.second / w;
+        int next[] = { x ? e.second - 1 : -1,
+                       x + 1 < w ? e.second + 1 : -1,
+                       y ? e.second - w : -1,
+                       y + 1 < w ? e.second + w : -1 };
+        for ( int i = 0; i < 4; i++ ) {
+            int u = next[i];
+            if ( u < 0 ) { continue; }
+            int d = e.first + 1 + ( e.second * 31 + u * 17 ) % 9;
+            if ( dist[u] < 0 ) {
+                dist[u]   = d;
+                queued[u] = 1;
+                handle[u] = heap.push( entry( d, u ) );
+            } else if ( queued[u] && d < dist[u] ) {
+                dist[u] = d;
+                heap.decrease_key( handle[u], entry( d, u ) );
+            }
+        }
+    }
+    return dist;
+}
 
-template <> struct Vallocator< void > {
-    typedef void              value_type;
-    typedef value_type       *pointer;
-    typedef const value_type *const_pointer;
-    typedef std::size_t       size_type;
-    typedef std::ptrdiff_t    difference_type;
+/* q.push_range, or one push at a time for std */
+template < typename Queue, typename InputIterator >
+void push_range( Queue &q, InputIterator first, InputIterator last ) {
+#if NS_IS_FT
+    q.push_range( first, last );
+#else
+    for ( ; first != last; first++ ) { q.push( *first ); }
+#endif
+}
 
-    template < class U > struct rebind {
-        typedef Vallocator< U > other;
-    };
+/* ---------------------------------- Ring ---------------------------------- */
+
+/*
+ * Pushes 0 to n - 1 into ring from another thread, in batches of batch.
+ * Both sides yield on a full or empty ring, single cores included.
+ */
+template < typename Ring > struct Ring_producer {
+    Ring     &ring;
+    int       n;
+    int       batch;
+    pthread_t thread;
+
+    static void *run( void *p ) {
+        Ring_producer    &self = *static_cast< Ring_producer * >( p );
+        NS::vector< int > values( self.batch );
+        for ( int i = 0; i < self.n; ) {
+            int k = std::min( self.batch, self.n - i );
+            for ( int j = 0; j < k; j++ ) { values[j] = i + j; }
+            int pushed = int( self.ring.try_push_n( values.begin(), k ) );
+            if ( !pushed ) { sched_yield(); }
+            i += pushed;
+        }
+        return 0;
+    }
 };
 
-template < typename T > struct Vallocator {
-    typedef T                 value_type;
-    typedef value_type       &reference;
-    typedef const value_type &const_reference;
-    typedef value_type       *pointer;
-    typedef const value_type *const_pointer;
-    typedef std::size_t       size_type;
-    typedef std::ptrdiff_t    difference_type;
-
-    template < typename U > struct rebind {
-        typedef Vallocator< U > other;
-    };
-
-    Vallocator() throw() {}
-    template < typename U > Vallocator( Vallocator< U > const & ) throw() {}
-
-    pointer allocate( const size_type &n,
-                      Vallocator< void >::const_pointer = 0 ) {
-        if ( n ) { _n_allocation++; }
-        return static_cast< pointer >(
-            ::operator new( n * sizeof( value_type ) ) );
+/* What a consumer makes of n values from a producer thread: out of order? */
+template < typename Ring > std::string ring_transfer( int n, int batch ) {
+    Ring                  ring( 64 );
+    Ring_producer< Ring > producer = { ring, n, batch, pthread_t() };
+    NS::vector< int >     values;
+    std::ostringstream    os;
+    long                  sum     = 0;
+    int                   next    = 0;
+    bool                  ordered = true;
+
+    pthread_create( &producer.thread,
+                    0,
+                    Ring_producer< Ring >::run,
+                    &producer );
+    while ( next < n ) {
+        values.clear();
+        if ( !ring.try_pop_n( std::back_inserter( values ), batch ) ) {
+            sched_yield();
+        }
+        for ( std::size_t i = 0; i < values.size(); i++, next++ ) {
+            ordered = ordered && values[i] == next;
+            sum += values[i];
+        }
+    }
+    pthread_join( producer.thread, 0 );
+    os << "{sum: " << sum << ", ordered: " << ordered
+       << ", empty: " << ring.empty() << "}";
+    return os.str();
+}
+
+/* ----------------------------- Pool allocator ----------------------------- */
+
+/* Churns a map of its own, the same pool as the other threads' underneath */
+template < typename Map > void *churn_map( void *p ) {
+    long &sum = *static_cast< long * >( p );
+    Map   m;
+    for ( int round = 0; round < 20; round++ ) {
+        for ( int i = 0; i < 2000; i++ ) { m[i * 7919 % 2000]; }
+        for ( int i = 0; i < 2000; i += 2 ) { m.erase( i ); }
+        for ( typename Map::iterator it = m.begin(); it != m.end(); it++ ) {
+            sum += it->first;
+        }
+        m.clear();
     }
-    void deallocate( pointer p, const size_type &n ) {
-        if ( n ) { _n_allocation--; }
-        ::operator delete( p );
+    return 0;
+}
+
+/* Destroyed after main returns, after any pool its nodes came from */
+NS::map< int,
+         int,
+         std::less< int >,
+         POOL_ALLOCATOR< NS::pair< const int, int > > >
+    static_pool_map;
+
+/* What four threads with a map each sum up */
+template < typename Map > std::string churn_maps() {
+    pthread_t          threads[4];
+    long               sums[4] = { 0, 0, 0, 0 };
+    std::ostringstream os;
+
+    for ( int i = 0; i < 4; i++ ) {
+        pthread_create( &threads[i], 0, churn_map< Map >, &sums[i] );
     }
-    void construct( pointer p, value_type const &val ) {
-        _n_construction++;
-        ::new ( p ) value_type( val );
+    for ( int i = 0; i < 4; i++ ) {
+        pthread_join( threads[i], 0 );
+        os << sums[i] << ' ';
     }
-    void destroy( pointer p ) {
-        if ( _n_construction ) { _n_construction--; }
-        p->~value_type();
+    return os.str();
+}
+
+/* ---------------------------- Concurrent stack ---------------------------- */
+
+/* Pushes n values from first on, and pops after every other push */
+template < typename Stack > struct Stack_worker {
+    Stack            *stack;
+    int               first;
+    int               n;
+    NS::vector< int > popped;
+    pthread_t         thread;
+
+    static void *run( void *p ) {
+        Stack_worker &self = *static_cast< Stack_worker * >( p );
+        int           x;
+        for ( int i = 0; i < self.n; i++ ) {
+            self.stack->push( self.first + i );
+            if ( i % 2 && self.stack->pop( x ) ) { self.popped.push_back( x ); }
+        }
+        return 0;
     }
+};
 
-    size_type max_size() const throw() {
-        return std::numeric_limits< size_type >::max() / sizeof( value_type );
+/* How many values come out exactly once when threads share the stack */
+template < typename Stack > std::string stack_shuffle( int threads, int n ) {
+    Stack                               stack;
+    NS::vector< Stack_worker< Stack > > workers( threads );
+    NS::vector< int >                   seen( threads * n, 0 );
+    std::ostringstream                  os;
+    int                                 once = 0;
+    int                                 x;
+
+    for ( int i = 0; i < threads; i++ ) {
+        workers[i].stack = &stack;
+        workers[i].first = i * n;
+        workers[i].n     = n;
+        pthread_create( &workers[i].thread,
+                        0,
+                        Stack_worker< Stack >::run,
+                        &workers[i] );
     }
-    pointer       address( reference x ) const { return &x; }
-    const_pointer address( const_reference x ) const { return &x; }
+    for ( int i = 0; i < threads; i++ ) {
+        pthread_join( workers[i].thread, 0 );
+        for ( std::size_t j = 0; j < workers[i].popped.size(); j++ ) {
+            seen[workers[i].popped[j]]++;
+        }
+    }
+    while ( stack.pop( x ) ) { seen[x]++; }
+    for ( std::size_t i = 0; i < seen.size(); i++ ) { once += seen[i] == 1; }
+    os << "{values: " << seen.size() << ", once: " << once
+       << ", empty: " << stack.empty() << "}";
+    return os.str();
+}
 
-    static size_type get_n_allocation() { return _n_allocation; }
-    static size_type get_n_construction() { return _n_construction; }
+/* -------------------------------- Parallel -------------------------------- */
 
-private:
-    static size_type _n_allocation;
-    static size_type _n_construction;
+/* Adds one */
+struct Increment {
+    template < typename T > void operator()( T &x ) const { x++; }
 };
 
-template < typename T >
-typename Vallocator< T >::size_type Vallocator< T >::_n_allocation;
-template < typename T >
-typename Vallocator< T >::size_type Vallocator< T >::_n_construction;
+struct Square {
+    long operator()( int x ) const { return long( x ) * x; }
+};
+
+/* Throws once it meets Value */
+template < int Value > struct Throw_at {
+    void operator()( int x ) const {
+        if ( x == Value ) { throw std::out_of_range( "Throw_at" ); }
+    }
+};
 
-template < typename T, typename U >
-bool operator==( Vallocator< T > const &, Vallocator< U > const & ) {
-    return true;
+/* ft::parallel on four threads and chunks of 7, or the sequential std */
+#if NS_IS_FT
+ft::parallel::thread_pool &test_pool() {
+    static ft::parallel::thread_pool pool( 4 );
+    return pool;
 }
-template < typename T, typename U >
-bool operator!=( Vallocator< T > const &x, Vallocator< U > const &y ) {
-    return !( x == y );
+#endif
+
+template < typename RandomIt, typename Function >
+void par_for_each( RandomIt first, RandomIt last, Function f ) {
+#if NS_IS_FT
+    ft::parallel::for_each( test_pool(), first, last, f, 7 );
+#else
+    std::for_each( first, last, f );
+#endif
 }
 
-/* ------------------------------ Mutant stack ------------------------------ */
+template < typename RandomIt, typename OutputIt, typename UnaryOperation >
+void par_transform( RandomIt       first,
+                    RandomIt       last,
+                    OutputIt       dst,
+                    UnaryOperation op ) {
+#if NS_IS_FT
+    ft::parallel::transform( test_pool(), first, last, dst, op, 7 );
+#else
+    std::transform( first, last, dst, op );
+#endif
+}
 
-template < typename T, typename C > struct S : public NS::stack< T, C > {
-    typedef typename NS::stack< T, C >::container_type::const_iterator
-        const_iterator;
-    typedef typename NS::stack< T, C >::container_type::const_reverse_iterator
-        const_reverse_iterator;
+template < typename RandomIt, typename T, typename BinaryOperation >
+T par_reduce( RandomIt first, RandomIt last, T init, BinaryOperation op ) {
+#if NS_IS_FT
+    return ft::parallel::reduce( test_pool(), first, last, init, op, 7 );
+#else
+    return std::accumulate( first, last, init, op );
+#endif
+}
 
-    S< T, C >() {}
-    S< T, C >( const S< T, C > &other ) : NS::stack< T, C >( other ) {}
-    S< T, C >( const NS::stack< T, C > &other ) : NS::stack< T, C >( other ) {}
-    S< T, C > &operator=( const S< T, C > &other ) {
-        NS::stack< T, C >::operator=( other );
-    }
+template < typename RandomIt, typename Compare >
+void par_sort( RandomIt first, RandomIt last, Compare comp ) {
+#if NS_IS_FT
+    ft::parallel::sort( test_pool(), first, last, comp, 7 );
+#else
+    std::sort( first, last, comp );
+#endif
+}
 
-    const_iterator         begin() const { return this->c.begin(); }
-    const_reverse_iterator rbegin() const { return this->c.rbegin(); }
-    const_iterator         end() const { return this->c.end(); }
-    const_reverse_iterator rend() const { return this->c.rend(); }
-};
+template < typename RandomIt, typename OutputIt >
+void par_uninitialized_copy( RandomIt first, RandomIt last, OutputIt dst ) {
+#if NS_IS_FT
+    ft::parallel::uninitialized_copy( test_pool(), first, last, dst, 7 );
+#else
+    std::uninitialized_copy( first, last, dst );
+#endif
+}
 
 /* ------------------------ ostream operator overload ----------------------- */
 
@@ -194,6 +454,20 @@ std::ostream &operator<<( std::ostream &os, const NS::vector< T, A > &v ) {
     return os;
 }
 
+template < typename T, typename A >
+std::ostream &operator<<( std::ostream &os, const NS::deque< T, A > &d ) {
+    os << "{size: " << d.size() << ", data: "
+       << "[";
+    for ( typename NS::deque< T, A >::const_iterator it = d.begin();
+          it != d.end();
+          it++ ) {
+        if ( it != d.begin() ) { os << ", "; }
+        os << *it;
+    }
+    os << "]}";
+    return os;
+}
+
 template < typename T, typename C >
 std::ostream &operator<<( std::ostream &os, const NS::stack< T, C > &s ) {
     S< T, C > ms( s );
@@ -727,6 +1001,406 @@ int main() {
             STREAM << v << std::endl;
             STREAM << v2 << std::endl;
         }
+        /* -------------------------- Trivially relocatable ------------------------- */
+        {
+            typedef NS::vector< int, Vallocator< int > > int_vector_type;
+
+            int_vector_type v;
+
+            for ( int i = 0; i < 100; i++ ) { v.push_back( i ); }
+            v.insert( v.begin() + 50, 7, -1 );
+            int_vector_type tail( v.begin() + 90, v.end() );
+            v.insert( v.begin(), tail.begin(), tail.end() );
+            v.insert( v.end(), 3, -2 );
+            v.erase( v.begin() + 10, v.begin() + 40 );
+            v.erase( v.begin() );
+            v.erase( v.end() - 1 );
+            v.resize( 200, -3 );
+            v.resize( 120 );
+
+            STREAM << v.size() << std::endl;
+            for ( int_vector_type::size_type i = 0; i < v.size(); i++ ) {
+                STREAM << v[i] << " ";
+            }
+            STREAM << std::endl;
+            STREAM << Vallocator< int >::get_n_construction() << std::endl;
+        }
+        /* ----------------------------- Input iterators ---------------------------- */
+        {
+            typedef std::istream_iterator< int > input_iterator;
+
+            std::istringstream a( "1 2 3 4 5 6 7 8 9" );
+            std::istringstream b( "10 11 12" );
+            std::istringstream c( "13 14 15 16" );
+            vector_type        v( ( input_iterator( a ) ), input_iterator() );
+
+            v.insert( v.begin() + 4, input_iterator( b ), input_iterator() );
+            v.insert( v.end(), input_iterator( c ), input_iterator() );
+            v.insert( v.begin(), input_iterator(), input_iterator() );
+
+            STREAM << v.size() << std::endl;
+            for ( vector_type::size_type i = 0; i < v.size(); i++ ) {
+                STREAM << v[i] << std::endl;
+            }
+
+            std::istringstream d( "17 18" );
+            v.assign( input_iterator( d ), input_iterator() );
+
+            STREAM << v.size() << std::endl;
+            for ( vector_type::size_type i = 0; i < v.size(); i++ ) {
+                STREAM << v[i] << std::endl;
+            }
+        }
+        /* ------------------------------ Default init ------------------------------ */
+        {
+            typedef NS::vector< int, Vallocator< int > > int_vector_type;
+
+            int_vector_type v( 5, 7 );
+
+#if NS_IS_FT
+            v.resize_and_overwrite( 20, Squares() );
+#else
+            v.resize( 20 );
+            v.resize( Squares()( v.data(), v.size() ) );
+#endif
+            STREAM << v.size() << std::endl;
+            for ( int_vector_type::size_type i = 0; i < v.size(); i++ ) {
+                STREAM << v[i] << std::endl;
+            }
+#if NS_IS_FT
+            v.resize_and_overwrite( 4, Squares() );
+            v.resize( 1000, ft::default_init );
+            v.resize( 2, ft::default_init );
+#else
+            v.resize( 4 );
+            v.resize( Squares()( v.data(), v.size() ) );
+            v.resize( 1000 );
+            v.resize( 2 );
+#endif
+            STREAM << v.size() << std::endl;
+            for ( int_vector_type::size_type i = 0; i < v.size(); i++ ) {
+                STREAM << v[i] << std::endl;
+            }
+
+#if NS_IS_FT
+            vector_type w( 4, ft::default_init );
+            w.resize( 6, ft::default_init );
+#else
+            vector_type w( 4 );
+            w.resize( 6 );
+#endif
+            STREAM << w.size() << std::endl;
+            for ( vector_type::size_type i = 0; i < w.size(); i++ ) {
+                STREAM << w[i] << std::endl;
+            }
+        }
+        /* -------------------------------- Erase if -------------------------------- */
+        {
+            typedef NS::vector< int, Vallocator< int > > int_vector_type;
+
+            int_vector_type v;
+
+            for ( int i = 0; i < 1000; i++ ) { v.push_back( i * 7 % 1000 ); }
+
+            STREAM << erase_where( v, Multiple< 100 >() ) << std::endl;
+            STREAM << erase_where( v, Multiple< 3 >() ) << std::endl;
+            STREAM << v.size() << std::endl;
+            for ( int_vector_type::size_type i = 0; i < v.size(); i++ ) {
+                STREAM << v[i] << " ";
+            }
+            STREAM << std::endl;
+
+            vector_type w( 5 );
+            std::generate( w.begin(), w.end(), f );
+
+            STREAM << erase_where( w, Multiple< 2 >() ) << std::endl;
+            STREAM << w.size() << std::endl;
+            for ( vector_type::size_type i = 0; i < w.size(); i++ ) {
+                STREAM << w[i] << std::endl;
+            }
+        }
+        /* ------------------------------ Growth policy ----------------------------- */
+        {
+#if NS_IS_FT
+            typedef ft::vector< mapped_type,
+                                Vallocator< mapped_type >,
+                                ft::growth_chunk< 3 > >
+                chunk_vector_type;
+            typedef ft::vector< mapped_type,
+                                Vallocator< mapped_type >,
+                                ft::growth_size_class<> >
+                size_class_vector_type;
+            typedef ft::vector< int,
+                                Vallocator< int >,
+                                ft::growth_size_class<> >
+                size_class_int_vector_type;
+#else
+            typedef vector_type chunk_vector_type;
+            typedef vector_type size_class_vector_type;
+            typedef std::vector< int, Vallocator< int > >
+                size_class_int_vector_type;
+#endif
+            Vallocator< int >::size_type n_element
+                = Vallocator< int >::get_n_element();
+            chunk_vector_type          v;
+            size_class_vector_type     v2;
+            size_class_int_vector_type v3;
+
+            for ( int i = 0; i < 10; i++ ) {
+                v.push_back( f() );
+                v2.push_back( f() );
+            }
+            v.insert( v.begin() + 4, 5, f() );
+            v2.insert( v2.begin() + 4, v.begin(), v.end() );
+
+            STREAM << ( v.capacity() >= v.size() ) << std::endl;
+            STREAM << ( v2.capacity() >= v2.size() ) << std::endl;
+            STREAM << vector_type( v.begin(), v.end() ) << std::endl;
+            STREAM << vector_type( v2.begin(), v2.end() ) << std::endl;
+
+            for ( int i = 0; i < 10; i++ ) { v3.push_back( i ); }
+            size_class_int_vector_type().swap( v3 );
+
+            STREAM << Vallocator< int >::get_n_element() - n_element
+                   << std::endl;
+        }
+        /* ----------------------------- Mmap allocator ----------------------------- */
+        {
+            typedef NS::vector< int, MMAP_ALLOCATOR< int > > mmap_vector_type;
+
+            mmap_vector_type v;
+            long             sum = 0;
+
+            for ( int i = 0; i < 1000000; i++ ) { v.push_back( i ); }
+            v.insert( v.begin() + 1, 5, -1 );
+            v.erase( v.begin() + 100, v.begin() + 200000 );
+            for ( mmap_vector_type::size_type i = 0; i < v.size(); i++ ) {
+                sum += v[i];
+            }
+
+            STREAM << v.size() << std::endl;
+            STREAM << sum << std::endl;
+            STREAM << v.front() << " " << v[3] << " " << v.back() << std::endl;
+
+            mmap_vector_type v2( v );
+
+            v.clear();
+            v.swap( v2 );
+
+            STREAM << ( v == mmap_vector_type( v ) ) << std::endl;
+            STREAM << v.size() << " " << v2.size() << std::endl;
+        }
+        /* ---------------------------------- Simd ---------------------------------- */
+        {
+            typedef NS::vector< int, ALIGNED_ALLOCATOR< int > > int_vector_type;
+            typedef NS::vector< char > char_vector_type;
+
+            int_vector_type  v;
+            char_vector_type c;
+
+            for ( int i = 0; i < 1000; i++ ) {
+                v.push_back( i * 7919 % 1013 - 500 );
+                c.push_back( static_cast< char >( i * 31 % 256 ) );
+            }
+
+            int_vector_type  v2( v );
+            char_vector_type c2( c );
+
+            STREAM << ( v == v2 ) << ( v < v2 ) << ( c == c2 ) << ( c < c2 )
+                   << std::endl;
+            v2[999]++;
+            c2[600] = static_cast< char >( c2[600] - 1 );
+            STREAM << ( v == v2 ) << ( v < v2 ) << ( c == c2 ) << ( c < c2 )
+                   << std::endl;
+            v2.pop_back();
+            STREAM << ( v == v2 ) << ( v < v2 ) << ( v2 < v ) << std::endl;
+
+            STREAM << NS::find( v.begin(), v.end(), 13 ) - v.begin()
+                   << std::endl;
+            STREAM << NS::find( c.begin(), c.end(), char( -3 ) ) - c.begin()
+                   << std::endl;
+            STREAM << ( NS::find( v.begin(), v.end(), 5000 ) == v.end() )
+                   << std::endl;
+            STREAM << NS::count( v.begin(), v.end(), 13 ) << std::endl;
+            STREAM << NS::count( c.begin(), c.end(), char( -3 ) ) << std::endl;
+            STREAM << *NS::min_element( v.begin(), v.end() ) << " "
+                   << NS::min_element( v.begin(), v.end() ) - v.begin()
+                   << std::endl;
+            STREAM << *NS::max_element( v.begin(), v.end() ) << " "
+                   << NS::max_element( v.begin(), v.end() ) - v.begin()
+                   << std::endl;
+            STREAM << int( *NS::min_element( c.begin(), c.end() ) ) << " "
+                   << int( *NS::max_element( c.begin(), c.end() ) )
+                   << std::endl;
+
+            NS::fill( v.begin() + 10, v.end() - 10, 42 );
+            NS::copy( v.begin(), v.begin() + 20, v.end() - 20 );
+            STREAM << NS::count( v.begin(), v.end(), 42 ) << std::endl;
+            STREAM << v[5] << " " << v[985] << " " << v[995] << std::endl;
+            std::size_t misalignment = 0;
+#if NS_IS_FT
+            misalignment = reinterpret_cast< std::size_t >( v.data() ) % 64;
+#endif
+            STREAM << misalignment << std::endl;
+        }
+        /* -------------------------------- Parallel -------------------------------- */
+        {
+            typedef NS::vector< int > int_vector_type;
+
+            int_vector_type v;
+
+            for ( int i = 0; i < 1000; i++ ) { v.push_back( i * 7919 % 1013 ); }
+            par_sort( v.begin(), v.end(), std::greater< int >() );
+            for ( int_vector_type::size_type i = 0; i < v.size(); i += 37 ) {
+                STREAM << v[i] << " ";
+            }
+            STREAM << std::endl;
+
+            NS::vector< long > w( v.size() );
+
+            par_for_each( v.begin(), v.end(), Increment() );
+            par_transform( v.begin(), v.end(), w.begin(), Square() );
+            STREAM << v.front() << " " << w.front() << " " << w.back()
+                   << std::endl;
+            STREAM << par_reduce( w.begin(), w.end(), 1L, std::plus< long >() )
+                   << std::endl;
+
+            NS::vector< std::string > s;
+
+            for ( int i = 0; i < 100; i++ ) {
+                s.push_back( std::string( 1, char( 'a' + i * 7 % 26 ) ) );
+            }
+            STREAM << par_reduce( s.begin(),
+                                  s.end(),
+                                  std::string( ">" ),
+                                  std::plus< std::string >() )
+                   << std::endl;
+            par_sort( s.begin(), s.end(), std::less< std::string >() );
+            STREAM << s.front() << s[50] << s.back() << std::endl;
+
+            vector_type                   x( 50 );
+            std::allocator< mapped_type > alloc;
+            mapped_type                  *p = alloc.allocate( x.size() );
+
+            std::generate( x.begin(), x.end(), f );
+            par_uninitialized_copy( x.begin(), x.end(), p );
+            for ( vector_type::size_type i = 0; i < x.size(); i++ ) {
+                STREAM << p[i] << " ";
+                p[i].~mapped_type();
+            }
+            STREAM << std::endl;
+            alloc.deallocate( p, x.size() );
+
+            try {
+                par_for_each( v.begin(), v.end(), Throw_at< 42 >() );
+                STREAM << "no throw" << std::endl;
+            } catch ( ... ) {
+                STREAM << "threw" << std::endl;
+            }
+        }
+        /* ------------------------------ Small vector ------------------------------ */
+        {
+            typedef SMALL_VECTOR( mapped_type, 4 ) small_vector_type;
+
+            small_vector_type v;
+
+            for ( int i = 0; i < 3; i++ ) { v.push_back( f() ); }
+
+            small_vector_type v2( v );
+
+            for ( int i = 0; i < 6; i++ ) { v2.push_back( f() ); }
+            v.swap( v2 );
+            v2.insert( v2.begin() + 1, 2, f() );
+            v.erase( v.begin() + 2, v.end() - 1 );
+
+            STREAM << vector_type( v.begin(), v.end() ) << std::endl;
+            STREAM << vector_type( v2.begin(), v2.end() ) << std::endl;
+
+            v = v2;
+            v2.clear();
+            v2.push_back( f() );
+
+            STREAM << vector_type( v.begin(), v.end() ) << std::endl;
+            STREAM << vector_type( v2.begin(), v2.end() ) << std::endl;
+            STREAM << ( v < v2 ) << std::endl;
+            STREAM << Vallocator< mapped_type >::get_n_construction()
+                   << std::endl;
+        }
+#if __cplusplus >= 201103L
+        /* ---------------------------------- Move ---------------------------------- */
+        {
+            vector_type v;
+            mapped_type x( f() );
+
+            for ( int i = 0; i < 20; i++ ) { v.push_back( mapped_type( f() ) ); }
+            v.push_back( std::move( x ) );
+            v.emplace_back( f() );
+            v.emplace_back();
+
+            STREAM << v << std::endl;
+            STREAM << *v.emplace( v.begin(), f() ) << std::endl;
+            STREAM << *v.emplace( v.begin() + 10, v[3] ) << std::endl;
+            STREAM << *v.emplace( v.end(), f() ) << std::endl;
+            STREAM << v << std::endl;
+
+            while ( v.size() < v.capacity() ) { v.push_back( v[1] ); }
+            v.emplace_back( v[0] );
+            while ( v.size() < v.capacity() ) { v.push_back( v[1] ); }
+            v.push_back( std::move( v[2] ) );
+            v[2] = v.back();
+
+            STREAM << v << std::endl;
+
+            vector_type v2( std::move( v ) );
+
+            STREAM << v << std::endl;
+            STREAM << v2 << std::endl;
+            STREAM << std::is_nothrow_move_constructible< vector_type >::value
+                   << std::is_nothrow_move_assignable< vector_type >::value
+                   << std::endl;
+        }
+        {
+            typedef SMALL_VECTOR( mapped_type, 4 ) small_vector_type;
+
+            small_vector_type v;
+
+            for ( int i = 0; i < 3; i++ ) { v.push_back( f() ); }
+
+            small_vector_type v2( std::move( v ) );
+
+            v.push_back( f() );
+            for ( int i = 0; i < 6; i++ ) { v2.push_back( f() ); }
+
+            small_vector_type v3( std::move( v2 ) );
+
+            v2 = std::move( v );
+            v = std::move( v3 );
+            v3.push_back( f() );
+
+            small_vector_type w;
+
+            w.swap( v2 );
+            v.swap( w );
+            swap( v2, v3 );
+
+            STREAM << vector_type( v.begin(), v.end() ) << std::endl;
+            STREAM << vector_type( v2.begin(), v2.end() ) << std::endl;
+            STREAM << vector_type( v3.begin(), v3.end() ) << std::endl;
+            STREAM << vector_type( w.begin(), w.end() ) << std::endl;
+        }
+#endif
+        /* --------------------------------- Aliases -------------------------------- */
+        {
+            vector_type v;
+
+            for ( int i = 0; i < 5; i++ ) { v.push_back( mapped_type( f() ) ); }
+            while ( v.size() < v.capacity() ) { v.push_back( v[0] ); }
+            v.push_back( v[1] );
+            v.insert( v.begin(), 2, v.back() );
+            v.insert( v.begin() + 1, v.capacity() - v.size() + 1, v[3] );
+
+            STREAM << v << std::endl;
+        }
         /* -------------------------- Relational operators -------------------------- */
         {
             const mapped_type arr[] = { f(), f(), f(), f(), f() };
@@ -752,51 +1426,283 @@ int main() {
             STREAM << ( v != v3 ) << std::endl;
             STREAM << ( v != v4 ) << std::endl;
 
-            STREAM << ( v < v1 ) << std::endl;
-            STREAM << ( v < v2 ) << std::endl;
-            STREAM << ( v < v3 ) << std::endl;
-            STREAM << ( v < v4 ) << std::endl;
+            STREAM << ( v < v1 ) << std::endl;
+            STREAM << ( v < v2 ) << std::endl;
+            STREAM << ( v < v3 ) << std::endl;
+            STREAM << ( v < v4 ) << std::endl;
+
+            STREAM << ( v > v1 ) << std::endl;
+            STREAM << ( v > v2 ) << std::endl;
+            STREAM << ( v > v3 ) << std::endl;
+            STREAM << ( v > v4 ) << std::endl;
+
+            STREAM << ( v <= v1 ) << std::endl;
+            STREAM << ( v <= v2 ) << std::endl;
+            STREAM << ( v <= v3 ) << std::endl;
+            STREAM << ( v <= v4 ) << std::endl;
+
+            STREAM << ( v >= v1 ) << std::endl;
+            STREAM << ( v >= v2 ) << std::endl;
+            STREAM << ( v >= v3 ) << std::endl;
+            STREAM << ( v >= v4 ) << std::endl;
+        }
+        /* ---------------------------------- Swap ---------------------------------- */
+        {
+            vector_type v1( 10 );
+            std::generate( v1.begin(), v1.end(), f );
+            vector_type v2( 4, f() );
+
+            NS::swap( v1, v2 );
+
+            STREAM << v1 << std::endl;
+            STREAM << v2 << std::endl;
+        }
+        /* -------------------------------- Allocator ------------------------------- */
+        {
+            STREAM << vector_type().get_allocator().get_n_allocation()
+                   << std::endl;
+            STREAM << vector_type().get_allocator().get_n_construction()
+                   << std::endl;
+        }
+        /* -------------------------------------------------------------------------- */
+    }
+#endif
+#if DEQUE_TEST
+    /* ---------------------------------- Deque --------------------------------- */
+    {
+        typedef NS::deque< mapped_type, Vallocator< mapped_type > > deque_type;
+        typedef const deque_type const_deque_type;
+
+        /* ------------------------------ Construction ------------------------------ */
+        {
+            const mapped_type arr[] = { f(), f(), f(), f(), f() };
+
+            deque_type d1;
+            deque_type d2( 7, f() );
+            deque_type d3( arr, arr + sizeof( arr ) / sizeof( mapped_type ) );
+            deque_type d4( d3 );
+            const_deque_type cd( d2 );
+
+            STREAM << d1 << std::endl;
+            STREAM << d2 << std::endl;
+            STREAM << d3 << std::endl;
+            STREAM << d4 << std::endl;
+            STREAM << cd << std::endl;
+
+            d1 = d3;
+            d3.assign( 3, f() );
+
+            STREAM << d1 << std::endl;
+            STREAM << d3 << std::endl;
+            STREAM << d1.empty() << ' ' << deque_type().empty() << std::endl;
+        }
+        /* ---------------------------------- Ends ---------------------------------- */
+        {
+            deque_type d;
+
+            for ( int i = 0; i < 3000; i++ ) {
+                i % 3 ? d.push_back( f() ) : d.push_front( f() );
+            }
+
+            STREAM << d.size() << std::endl;
+            STREAM << d.front() << ' ' << d.back() << std::endl;
+
+            for ( int i = 0; i < 1000; i++ ) { d.pop_front(); }
+            for ( int i = 0; i < 1500; i++ ) { d.pop_back(); }
+
+            STREAM << d.size() << std::endl;
+            STREAM << d.front() << ' ' << d.back() << std::endl;
+
+            /* A queue walking through the map */
+            for ( int i = 0; i < 5000; i++ ) {
+                d.push_back( f() );
+                d.pop_front();
+            }
+
+            STREAM << d.size() << std::endl;
+            STREAM << d.front() << ' ' << d.back() << std::endl;
+
+            while ( !d.empty() ) { d.pop_back(); }
+            d.push_front( f() );
+
+            STREAM << d << std::endl;
+        }
+        /* --------------------------------- Insert --------------------------------- */
+        {
+            const mapped_type arr[] = { f(), f(), f() };
+
+            deque_type d( 10 );
+            std::generate( d.begin(), d.end(), f );
+
+            STREAM << *d.insert( d.begin() + 2, f() ) << std::endl;
+            STREAM << *d.insert( d.end() - 2, f() ) << std::endl;
+            STREAM << d << std::endl;
+
+            d.insert( d.begin() + 1, 3, f() );
+            d.insert( d.end() - 1, 4, f() );
+            d.insert( d.begin(), 2, d[5] );
+            d.insert( d.end(), 2, d[5] );
+
+            STREAM << d << std::endl;
+
+            d.insert( d.begin() + 3, arr, arr + 3 );
+            d.insert( d.end() - 3, arr, arr + 3 );
+            d.insert( d.begin() + d.size() / 2, arr, arr + 3 );
+
+            STREAM << d << std::endl;
+
+            std::istringstream str( "1 2 3 4 5" );
+            std::istream_iterator< int > it( str ), end;
+            NS::deque< int > di( 4, 0 );
+            di.insert( di.begin() + 1, it, end );
+
+            STREAM << di << std::endl;
+        }
+        /* ---------------------------------- Erase --------------------------------- */
+        {
+            deque_type d( 40 );
+            std::generate( d.begin(), d.end(), f );
+
+            STREAM << *d.erase( d.begin() + 3 ) << std::endl;
+            STREAM << *d.erase( d.end() - 4 ) << std::endl;
+            STREAM << *d.erase( d.begin() + 2, d.begin() + 8 ) << std::endl;
+            STREAM << *d.erase( d.end() - 12, d.end() - 3 ) << std::endl;
+            STREAM << d << std::endl;
+            STREAM << ( d.erase( d.begin(), d.end() ) == d.end() ) << std::endl;
+            STREAM << d << std::endl;
+        }
+        /* -------------------------------- Erase if -------------------------------- */
+        {
+            deque_type d( 30 );
+            std::generate( d.begin(), d.end(), f );
+
+            STREAM << erase_where( d, Multiple< 3 >() ) << std::endl;
+            STREAM << d << std::endl;
+            STREAM << erase_where( d, Apart< 1000 >() ) << std::endl;
+            STREAM << d << std::endl;
+        }
+        /* ----------------------------- Element access ----------------------------- */
+        {
+            deque_type d( 600 );
+            std::generate( d.begin(), d.end(), f );
+            const_deque_type cd( d );
+
+            STREAM << d[0] << ' ' << d[299] << ' ' << cd[599] << std::endl;
+            STREAM << d.at( 512 ) << ' ' << cd.at( 3 ) << std::endl;
+            try {
+                d.at( 600 );
+            } catch ( const std::out_of_range & ) {
+                STREAM << "out_of_range" << std::endl;
+            }
+
+            d.front() = f();
+            d.back()  = f();
+            d[200]    = f();
+
+            STREAM << d.front() << ' ' << d[200] << ' ' << d.back()
+                   << std::endl;
+        }
+        /* -------------------------------- Iterators ------------------------------- */
+        {
+            deque_type d;
+            for ( int i = 0; i < 700; i++ ) {
+                i % 2 ? d.push_back( f() ) : d.push_front( f() );
+            }
+            const_deque_type cd( d );
+
+            deque_type::iterator       it  = d.begin() + 350;
+            deque_type::const_iterator cit = it;
+
+            STREAM << *it << ' ' << *( it - 300 ) << ' ' << *( 300 + it )
+                   << std::endl;
+            STREAM << ( d.end() - it ) << ' ' << ( cit - d.begin() )
+                   << std::endl;
+            STREAM << ( it == cit ) << ' ' << ( cit < d.end() ) << ' '
+                   << ( it >= d.begin() + 351 ) << std::endl;
+
+            it += 200;
+            it -= 520;
+
+            STREAM << *it << ' ' << it[400] << std::endl;
+            STREAM << *d.rbegin() << ' ' << *( cd.rend() - 1 ) << std::endl;
+            STREAM << std::distance( cd.rbegin(), cd.rend() ) << std::endl;
+
+            std::sort( d.begin(), d.end() );
+
+            STREAM << d.front() << ' ' << d.back() << std::endl;
+        }
+        /* --------------------------------- Resize --------------------------------- */
+        {
+            deque_type d( 5, f() );
+
+            d.resize( 1000, f() );
+
+            STREAM << d.size() << ' ' << d[4] << ' ' << d[999] << std::endl;
 
-            STREAM << ( v > v1 ) << std::endl;
-            STREAM << ( v > v2 ) << std::endl;
-            STREAM << ( v > v3 ) << std::endl;
-            STREAM << ( v > v4 ) << std::endl;
+            d.resize( 3 );
 
-            STREAM << ( v <= v1 ) << std::endl;
-            STREAM << ( v <= v2 ) << std::endl;
-            STREAM << ( v <= v3 ) << std::endl;
-            STREAM << ( v <= v4 ) << std::endl;
+            STREAM << d << std::endl;
 
-            STREAM << ( v >= v1 ) << std::endl;
-            STREAM << ( v >= v2 ) << std::endl;
-            STREAM << ( v >= v3 ) << std::endl;
-            STREAM << ( v >= v4 ) << std::endl;
+            d.clear();
+
+            STREAM << d << std::endl;
         }
         /* ---------------------------------- Swap ---------------------------------- */
         {
-            vector_type v1( 10 );
-            std::generate( v1.begin(), v1.end(), f );
-            vector_type v2( 4, f() );
+            deque_type d1( 10 );
+            std::generate( d1.begin(), d1.end(), f );
+            deque_type d2( 4, f() );
 
-            NS::swap( v1, v2 );
+            mapped_type *p = &d1.front();
 
-            STREAM << v1 << std::endl;
-            STREAM << v2 << std::endl;
+            NS::swap( d1, d2 );
+
+            STREAM << d1 << std::endl;
+            STREAM << d2 << std::endl;
+            STREAM << ( p == &d2.front() ) << std::endl;
         }
-        /* -------------------------------- Benchmark ------------------------------- */
+        /* ---------------------------- Stable addresses ---------------------------- */
         {
-            vector_type v;
-            mapped_type x = f();
+            deque_type d( 3, f() );
 
-            for ( vector_type::size_type i( 0 ); i < 10000000; i++ ) {
-                v.push_back( x );
+            mapped_type *front = &d.front();
+            mapped_type *back  = &d.back();
+
+            for ( int i = 0; i < 10000; i++ ) {
+                d.push_back( f() );
+                d.push_front( f() );
+            }
+            for ( int i = 0; i < 5000; i++ ) {
+                d.pop_back();
+                d.pop_front();
             }
+
+            STREAM << ( front == &d[5000] ) << ' ' << ( back == &d[5002] )
+                   << std::endl;
+            STREAM << d[5000] << ' ' << d[5002] << std::endl;
         }
-        /* -------------------------------- Allocator ------------------------------- */
+        /* -------------------------- Relational operators -------------------------- */
         {
-            STREAM << vector_type().get_allocator().get_n_allocation()
+            const mapped_type arr[] = { f(), f(), f(), f(), f() };
+
+            deque_type d( arr, arr + 5 );
+            deque_type d1;
+            deque_type d2( arr, arr + 3 );
+            deque_type d3( d );
+            d3.back() = f();
+            deque_type d4( d );
+
+            STREAM << ( d == d1 ) << ( d == d2 ) << ( d == d3 ) << ( d == d4 )
                    << std::endl;
-            STREAM << vector_type().get_allocator().get_n_construction()
+            STREAM << ( d != d1 ) << ( d != d2 ) << ( d != d3 ) << ( d != d4 )
+                   << std::endl;
+            STREAM << ( d < d1 ) << ( d < d2 ) << ( d < d3 ) << ( d < d4 )
+                   << std::endl;
+            STREAM << ( d > d1 ) << ( d > d2 ) << ( d > d3 ) << ( d > d4 )
+                   << std::endl;
+            STREAM << ( d <= d1 ) << ( d <= d2 ) << ( d <= d3 ) << ( d <= d4 )
+                   << std::endl;
+            STREAM << ( d >= d1 ) << ( d >= d2 ) << ( d >= d3 ) << ( d >= d4 )
                    << std::endl;
         }
         /* -------------------------------------------------------------------------- */
@@ -858,6 +1764,311 @@ int main() {
         STREAM << ( s >= s2 ) << std::endl;
         STREAM << ( s2 >= s ) << std::endl;
     }
+    {
+        typedef NS::stack< mapped_type, SMALL_VECTOR( mapped_type, 2 ) >
+            stack_type;
+
+        stack_type s;
+
+        for ( int i = 0; i < 5; i++ ) { s.push( f() ); }
+
+        stack_type s2( s );
+
+        STREAM << s << std::endl;
+
+        s.pop();
+        s.top() = f();
+
+        STREAM << s << std::endl;
+        STREAM << ( s < s2 ) << std::endl;
+        STREAM << ( s == s2 ) << std::endl;
+    }
+    {
+        typedef NS::stack< mapped_type > stack_type;
+
+        stack_type s;
+
+        for ( int i = 0; i < 3000; i++ ) { s.push( f() ); }
+
+        STREAM << s.size() << ' ' << s.top() << std::endl;
+
+        for ( int i = 0; i < 2990; i++ ) { s.pop(); }
+        stack_type s2( s );
+        s2.top() = f();
+
+        STREAM << s << std::endl;
+        STREAM << ( s < s2 ) << ' ' << ( s == s2 ) << std::endl;
+    }
+#endif
+#if PRIORITY_QUEUE_TEST
+    /* ----------------------------- Priority queue ----------------------------- */
+    {
+        typedef NS::priority_queue< mapped_type > queue_type;
+
+        const mapped_type arr[] = { f(), f(), f(), f(), f(), f(), f() };
+
+        queue_type q;
+
+        STREAM << popped( q ) << ' ' << q.empty() << std::endl;
+
+        for ( int i = 0; i < 20; i++ ) { q.push( f() * 37 % 101 ); }
+
+        STREAM << q.size() << ' ' << q.top() << std::endl;
+
+        q.pop();
+        q.pop();
+        q.push( q.top() );
+
+        STREAM << popped( q ) << std::endl;
+
+        queue_type q2( arr, arr + 7 );
+
+        STREAM << popped( q2 ) << std::endl;
+
+        NS::swap( q, q2 );
+
+        STREAM << q.size() << ' ' << q2.size() << std::endl;
+
+        /* A few appended elements sift up, many rebuild the heap */
+        push_range( q, arr, arr + 2 );
+
+        STREAM << popped( q ) << std::endl;
+
+        NS::vector< mapped_type > v( 50 );
+        std::generate( v.begin(), v.end(), f );
+        push_range( q, v.begin(), v.end() );
+
+        STREAM << popped( q ) << std::endl;
+
+        for ( int i = 0; i < 5; i++ ) { q.pop(); }
+
+        STREAM << q.size() << ' ' << q.top() << std::endl;
+    }
+    {
+        PRIORITY_QUEUE( int, std::less< int >, 2 ) q2;
+        PRIORITY_QUEUE( int, std::less< int >, 3 ) q3;
+        PRIORITY_QUEUE( int, std::less< int >, 8 ) q8;
+
+        for ( int i = 0; i < 1000; i++ ) {
+            int x = f() * 37 % 101;
+            q2.push( x );
+            q3.push( x );
+            q8.push( x );
+            if ( i % 3 ) {
+                q2.pop();
+                q3.pop();
+                q8.pop();
+            }
+        }
+
+        STREAM << popped( q2 ) << std::endl;
+        STREAM << ( popped( q2 ) == popped( q3 ) ) << ' '
+               << ( popped( q2 ) == popped( q8 ) ) << std::endl;
+    }
+    {
+        typedef NS::priority_queue< int,
+                                    NS::deque< int >,
+                                    std::greater< int > >
+            queue_type;
+
+        const int arr[] = { 5, 3, 9, 1, 7, 3, 8 };
+
+        queue_type q( arr, arr + 7 );
+        q.push( 4 );
+        q.push( 0 );
+
+        STREAM << popped( q ) << std::endl;
+
+        push_range( q, arr, arr + 7 );
+        q.pop();
+
+        STREAM << popped( q ) << std::endl;
+    }
+#endif
+#if PAIRING_HEAP_TEST
+    /* ------------------------------ Pairing heap ------------------------------ */
+    {
+        typedef PAIRING_HEAP( int, std::greater< int > ) heap_type;
+        typedef heap_type::handle_type handle_type;
+
+        heap_type                 h;
+        NS::vector< handle_type > handles;
+
+        STREAM << h.empty() << ' ' << h.size() << std::endl;
+
+        for ( int i = 0; i < 100; i++ ) {
+            handles.push_back( h.push( 1000 + i * 37 % 101 ) );
+        }
+
+        STREAM << h.size() << ' ' << h.top() << ' ' << *handles[10]
+               << std::endl;
+
+        h.decrease_key( handles[10], 5 );
+        h.decrease_key( handles[20], 7 );
+
+        STREAM << h.top() << ' ' << *handles[10] << std::endl;
+
+        h.pop();
+        h.update( handles[20], 2000 );
+        h.update( handles[30], 6 );
+        h.erase( handles[40] );
+        h.erase( handles[50] );
+
+        STREAM << h.size() << ' ' << h.top() << ' ' << *handles[20]
+               << std::endl;
+        STREAM << popped( h ) << std::endl;
+
+        heap_type other;
+        for ( int i = 0; i < 10; i++ ) { other.push( 500 + i * 3 ); }
+        handle_type moved = other.push( 3 );
+
+        h.merge( other );
+
+        STREAM << other.empty() << ' ' << h.size() << ' ' << h.top()
+               << std::endl;
+
+        h.decrease_key( handles[60], 1 );
+        h.erase( moved );
+
+        heap_type copy( h );
+        h.erase( handles[60] );
+
+        STREAM << popped( h ) << std::endl;
+        STREAM << popped( copy ) << std::endl;
+    }
+    {
+        typedef NS::pair< int, int >                            entry;
+        typedef PAIRING_HEAP( entry, std::greater< entry > ) heap_type;
+
+        NS::vector< int > dist = grid_distances< heap_type >( 40 );
+
+        STREAM << dist[0] << ' ' << dist[39] << ' ' << dist[820] << ' '
+               << dist.back() << ' '
+               << std::accumulate( dist.begin(), dist.end(), 0 ) << std::endl;
+    }
+#endif
+#if SPSC_RING_TEST
+    /* -------------------------------- SPSC ring ------------------------------- */
+    {
+        typedef SPSC_RING( int ) ring_type;
+
+        ring_type ring( 5 );
+        int       n = 0;
+
+        STREAM << ring.capacity() << ' ' << ring.empty() << std::endl;
+
+        while ( ring.try_push( n ) ) { n++; }
+
+        STREAM << n << ' ' << ring.size() << std::endl;
+
+        int x = -1;
+        for ( int i = 0; i < 3; i++ ) { ring.try_pop( x ); }
+
+        STREAM << x << ' ' << ring.size() << std::endl;
+
+        NS::vector< int > v;
+        for ( int i = 0; i < 10; i++ ) { v.push_back( 100 + i ); }
+        n = int( ring.try_push_n( v.begin(), v.size() ) );
+
+        STREAM << n << ' ' << ring.size() << std::endl;
+
+        v.clear();
+        n = int( ring.try_pop_n( std::back_inserter( v ), 6 ) );
+
+        STREAM << n << ' ' << v << std::endl;
+
+        n = int( ring.try_push_n( v.begin(), 2 ) );
+        v.clear();
+        ring.try_pop_n( std::back_inserter( v ), 100 );
+
+        STREAM << n << ' ' << v << ' ' << ring.empty() << ' '
+               << ring.try_pop( x ) << ' ' << x << std::endl;
+    }
+    {
+        typedef SPSC_RING( std::string ) ring_type;
+
+        ring_type                 ring( 4 );
+        NS::vector< std::string > v;
+        std::string               s;
+
+        for ( int i = 0; i < 6; i++ ) {
+            v.push_back( std::string( 20 + i, char( 'a' + i ) ) );
+        }
+        ring.try_push( v[0] );
+        ring.try_pop( s );
+        ring.try_push_n( v.begin() + 1, 5 );
+        ring.try_pop( s );
+
+        STREAM << s << ' ' << ring.size() << std::endl;
+    }
+    {
+        typedef SPSC_RING( int ) ring_type;
+
+        STREAM << ring_transfer< ring_type >( 200000, 1 ) << std::endl;
+        STREAM << ring_transfer< ring_type >( 200000, 48 ) << std::endl;
+    }
+#endif
+#if CONCURRENT_STACK_TEST
+    /* ---------------------------- Concurrent stack ---------------------------- */
+    {
+        typedef CONCURRENT_STACK( int ) stack_type;
+
+        stack_type s;
+        int        x = -1;
+
+        STREAM << s.empty() << ' ' << s.pop( x ) << ' ' << x << std::endl;
+
+        for ( int i = 0; i < 10; i++ ) { s.push( i * i ); }
+        s.pop( x );
+
+        STREAM << s.empty() << ' ' << x << std::endl;
+
+        std::ostringstream os;
+        while ( s.pop( x ) ) { os << x << ' '; }
+
+        STREAM << os.str() << s.empty() << std::endl;
+    }
+    {
+        typedef CONCURRENT_STACK( std::string ) stack_type;
+
+        stack_type  s;
+        std::string str;
+
+        for ( int i = 0; i < 5; i++ ) {
+            s.push( std::string( 20 + i, char( 'a' + i ) ) );
+        }
+        s.pop( str );
+        s.pop( str );
+        s.push( str + "!" );
+        s.pop( str );
+
+        STREAM << str << ' ' << s.empty() << std::endl;
+    }
+    {
+        typedef CONCURRENT_STACK( int ) stack_type;
+
+        STREAM << stack_shuffle< stack_type >( 4, 50000 ) << std::endl;
+    }
+#endif
+#if PAIR_TEST
+    /* ---------------------------------- Pair ---------------------------------- */
+    {
+        typedef NS::pair< int, int > pair_type;
+
+        /* Firsts decide, the seconds only break ties and order the other way */
+        pair_type p[] = { NS::make_pair( 1, 9 ),
+                          NS::make_pair( 2, 0 ),
+                          NS::make_pair( 2, 5 ),
+                          NS::make_pair( 2, 5 ) };
+
+        for ( int i = 0; i < 4; i++ ) {
+            for ( int j = 0; j < 4; j++ ) {
+                STREAM << ( p[i] < p[j] ) << ( p[i] <= p[j] )
+                       << ( p[i] > p[j] ) << ( p[i] >= p[j] )
+                       << ( p[i] == p[j] ) << ( p[i] != p[j] ) << std::endl;
+            }
+        }
+    }
 #endif
 #if MAP_TEST
     /* ----------------------------------- Map ---------------------------------- */
@@ -897,6 +2108,59 @@ int main() {
             STREAM << m3 << std::endl;
             STREAM << m1 << std::endl;
         }
+        /* ------------------------------ Sorted build ------------------------------ */
+        {
+            typedef NS::map< int, int > int_map_type;
+            typedef NS::pair< int, int > entry;
+
+            /* Around 2^k - 1 and away from it, sentinels not counted */
+            const int sizes[]
+                = { 0, 1, 2, 3, 4, 5, 6, 7, 12, 13, 14, 29, 30, 100 };
+
+            for ( int s = 0; s < 14; s++ ) {
+                NS::vector< entry > v;
+                for ( int i = 0; i < sizes[s]; i++ ) {
+                    v.push_back( entry( i * 2, i ) );
+                }
+
+                int_map_type m( v.begin(), v.end() );
+                int_map_type m2;
+
+                m2.insert( v.begin(), v.end() );
+
+                STREAM << m << std::endl;
+                STREAM << ( m == m2 ) << std::endl;
+
+                /* Rebalancing what was built leans on its colours */
+                for ( int i = 0; i < sizes[s]; i += 3 ) { m.erase( i * 2 ); }
+                for ( int i = 0; i < sizes[s]; i++ ) {
+                    m.insert( entry( i * 2 + 1, -i ) );
+                }
+
+                STREAM << m << std::endl;
+            }
+
+            /* Duplicates, then keys going back, fall back to inserts */
+            const entry dup[] = { entry( 1, 1 ), entry( 2, 2 ), entry( 2, 3 ),
+                                  entry( 4, 4 ), entry( 4, 5 ), entry( 4, 6 ),
+                                  entry( 8, 7 ) };
+            const entry back[] = { entry( 0, 0 ), entry( 2, 1 ), entry( 4, 2 ),
+                                   entry( 6, 3 ), entry( 3, 4 ), entry( 5, 5 ),
+                                   entry( 9, 6 ), entry( 1, 7 ) };
+
+            int_map_type m( dup, dup + 7 );
+            int_map_type m2( back, back + 8 );
+
+            STREAM << m << std::endl;
+            STREAM << m2 << std::endl;
+
+            m.erase( 2 );
+            m2.erase( 4 );
+            m2.insert( entry( 7, 8 ) );
+
+            STREAM << m << std::endl;
+            STREAM << m2 << std::endl;
+        }
         /* -------------------------------- Iterators ------------------------------- */
         {
             const map_type::value_type arr[]
@@ -1163,6 +2427,35 @@ int main() {
             STREAM << m << std::endl;
             STREAM << m2 << std::endl;
         }
+        /* ------------------------------ Hinted insert ----------------------------- */
+        {
+            typedef NS::map< int, int > int_map_type;
+            typedef NS::pair< int, int > entry;
+
+            int_map_type m;
+
+            for ( int i = 0; i < 200; i++ ) {
+                m.insert( m.end(), entry( i * 2, i ) );
+            }
+            for ( int i = 1; i < 50; i++ ) {
+                m.insert( m.begin(), entry( -i * 2, -i ) );
+            }
+
+            STREAM << m << std::endl;
+
+            /* Too far left, too far right, on an equal key, then fits */
+            STREAM << *m.insert( m.begin(), entry( 301, 1 ) ) << std::endl;
+            STREAM << *m.insert( m.end(), entry( 3, 2 ) ) << std::endl;
+            STREAM << *m.insert( m.find( 100 ), entry( 100, 3 ) ) << std::endl;
+            STREAM << *m.insert( m.find( 10 ), entry( 9, 4 ) ) << std::endl;
+            STREAM << *m.insert( m.find( 10 ), entry( 11, 5 ) ) << std::endl;
+            STREAM << *m.insert( m.find( 20 ), entry( 200, 6 ) ) << std::endl;
+            STREAM << *m.insert( m.find( 200 ), entry( 21, 7 ) ) << std::endl;
+            STREAM << *m.insert( m.end(), entry( 1000, 8 ) ) << std::endl;
+            STREAM << *m.insert( m.begin(), entry( -1000, 9 ) ) << std::endl;
+
+            STREAM << m << std::endl;
+        }
         /* -------------------------------- Observers ------------------------------- */
         {
             key_type x = g();
@@ -1281,13 +2574,111 @@ int main() {
             STREAM << ( m >= m3 ) << std::endl;
             STREAM << ( m >= m4 ) << std::endl;
         }
-        /* -------------------------------- Benchmark ------------------------------- */
+        /* ------------------------------- Try emplace ------------------------------ */
+        {
+            const value_type arr[] = { value_type( g(), f() ),
+                                       value_type( g(), f() ),
+                                       value_type( g(), f() ) };
+            map_type m( arr, arr + sizeof( arr ) / sizeof( value_type ) );
+            NS::pair< map_type::iterator, bool > res;
+            const key_type                       k( g() );
+            const mapped_type                    v( f() );
+            const mapped_type                    w( f() );
+
+#if NS_IS_FT
+            res = m.try_emplace( k, v );
+#else
+            res = m.insert( value_type( k, v ) );
+#endif
+            STREAM << res.second << " " << *res.first << std::endl;
+#if NS_IS_FT
+            res = m.try_emplace( k, w );
+#else
+            res = m.insert( value_type( k, w ) );
+#endif
+            STREAM << res.second << " " << *res.first << std::endl;
+#if NS_IS_FT
+            res = m.insert_or_assign( k, w );
+#else
+            res = m.insert( value_type( k, w ) );
+            if ( !res.second ) { res.first->second = w; }
+#endif
+            STREAM << res.second << " " << *res.first << std::endl;
+#if NS_IS_FT
+            res = m.insert_or_assign( arr[0].first, v );
+#else
+            res = m.insert( value_type( arr[0].first, v ) );
+            if ( !res.second ) { res.first->second = v; }
+#endif
+            STREAM << res.second << " " << *res.first << std::endl;
+#if NS_IS_FT
+            res = m.try_emplace( g() );
+#else
+            res = m.insert( value_type( g(), mapped_type() ) );
+#endif
+            STREAM << res.second << " " << *res.first << std::endl;
+            STREAM << m << std::endl;
+        }
+        /* -------------------------------- Erase if -------------------------------- */
+        {
+            typedef NS::map< int,
+                             mapped_type,
+                             std::less< int >,
+                             Vallocator< NS::pair< const int, mapped_type > > >
+                int_map_type;
+
+            int_map_type m;
+
+            for ( int i = 0; i < 2000; i++ ) { m[i * 7919 % 2000] = f(); }
+
+            STREAM << erase_where( m, Multiple< 100 >() ) << std::endl;
+            STREAM << erase_where( m, Multiple< 3 >() ) << std::endl;
+            STREAM << m.size() << std::endl;
+            STREAM << m << std::endl;
+
+            for ( int i = 0; i < 2000; i += 5 ) { m[i] = f(); }
+            for ( int i = 0; i < 2000; i += 11 ) { m.erase( i ); }
+
+            STREAM << m.size() << std::endl;
+            STREAM << *m.lower_bound( 1000 ) << std::endl;
+            STREAM << m << std::endl;
+            STREAM << erase_where( m, Apart< 10 >() ) << std::endl;
+            STREAM << m << std::endl;
+            STREAM << erase_where( m, Multiple< 1 >() ) << std::endl;
+            STREAM << m.size() << std::endl;
+            STREAM << ( m.begin() == m.end() ) << std::endl;
+        }
+        /* ----------------------------- Pool allocator ----------------------------- */
         {
-            map_type      m;
-            mapped_type   x = f();
-            F< key_type > h;
+            typedef NS::map<
+                int,
+                mapped_type,
+                std::less< int >,
+                POOL_ALLOCATOR< NS::pair< const int, mapped_type > > >
+                pool_map_type;
+
+            pool_map_type m;
 
-            for ( map_type::size_type i( 0 ); i < 1000000; i++ ) { m[h()] = x; }
+            for ( int i = 0; i < 5000; i++ ) { m[i * 7919 % 5000] = f(); }
+            for ( int i = 0; i < 5000; i += 3 ) { m.erase( i ); }
+
+            pool_map_type m2( m );
+
+            m.clear();
+            for ( int i = 0; i < 5000; i += 2 ) { m[i] = f(); }
+
+            STREAM << m.size() << std::endl;
+            STREAM << *m.begin() << std::endl;
+            STREAM << *m.rbegin() << std::endl;
+            STREAM << m2.size() << std::endl;
+            STREAM << *m2.find( 4999 ) << std::endl;
+            STREAM << ( m2.find( 4998 ) == m2.end() ) << std::endl;
+            STREAM << m2 << std::endl;
+            STREAM << churn_maps< pool_map_type >() << std::endl;
+
+            for ( int i = 0; i < 100; i++ ) { static_pool_map[i] = i; }
+
+            STREAM << static_pool_map.size() << std::endl;
         }
         /* -------------------------------- Allocator ------------------------------- */
         {
@@ -1326,6 +2717,50 @@ int main() {
 
             STREAM << s3 << std::endl;
         }
+        /* ------------------------------ Sorted build ------------------------------ */
+        {
+            typedef NS::set< int > int_set_type;
+
+            /* Around 2^k - 1 and away from it, sentinels not counted */
+            const int sizes[]
+                = { 0, 1, 2, 3, 4, 5, 6, 7, 12, 13, 14, 29, 30, 100 };
+
+            for ( int s = 0; s < 14; s++ ) {
+                NS::vector< int > v;
+                for ( int i = 0; i < sizes[s]; i++ ) { v.push_back( i * 2 ); }
+
+                int_set_type st( v.begin(), v.end() );
+                int_set_type st2;
+
+                st2.insert( v.begin(), v.end() );
+
+                STREAM << st << std::endl;
+                STREAM << ( st == st2 ) << std::endl;
+
+                /* Rebalancing what was built leans on its colours */
+                for ( int i = 0; i < sizes[s]; i += 3 ) { st.erase( i * 2 ); }
+                for ( int i = 0; i < sizes[s]; i++ ) { st.insert( i * 2 + 1 ); }
+
+                STREAM << st << std::endl;
+            }
+
+            /* Duplicates, then keys going back, fall back to inserts */
+            const int dup[]  = { 1, 2, 2, 4, 4, 4, 8 };
+            const int back[] = { 0, 2, 4, 6, 3, 5, 9, 1 };
+
+            int_set_type st( dup, dup + 7 );
+            int_set_type st2( back, back + 8 );
+
+            STREAM << st << std::endl;
+            STREAM << st2 << std::endl;
+
+            st.erase( 2 );
+            st2.erase( 4 );
+            st2.insert( 7 );
+
+            STREAM << st << std::endl;
+            STREAM << st2 << std::endl;
+        }
         /* -------------------------------- Iterators ------------------------------- */
         {
             const mapped_type arr[] = { f(), f(), f(), f() };
@@ -1483,6 +2918,30 @@ int main() {
             STREAM << s << std::endl;
             STREAM << s2 << std::endl;
         }
+        /* ------------------------------ Hinted insert ----------------------------- */
+        {
+            typedef NS::set< int > int_set_type;
+
+            int_set_type st;
+
+            for ( int i = 0; i < 200; i++ ) { st.insert( st.end(), i * 2 ); }
+            for ( int i = 1; i < 50; i++ ) { st.insert( st.begin(), -i * 2 ); }
+
+            STREAM << st << std::endl;
+
+            /* Too far left, too far right, on an equal key, then fits */
+            STREAM << *st.insert( st.begin(), 301 ) << std::endl;
+            STREAM << *st.insert( st.end(), 3 ) << std::endl;
+            STREAM << *st.insert( st.find( 100 ), 100 ) << std::endl;
+            STREAM << *st.insert( st.find( 10 ), 9 ) << std::endl;
+            STREAM << *st.insert( st.find( 10 ), 11 ) << std::endl;
+            STREAM << *st.insert( st.find( 20 ), 201 ) << std::endl;
+            STREAM << *st.insert( st.find( 200 ), 21 ) << std::endl;
+            STREAM << *st.insert( st.end(), 1000 ) << std::endl;
+            STREAM << *st.insert( st.begin(), -1000 ) << std::endl;
+
+            STREAM << st << std::endl;
+        }
         /* -------------------------------- Observers ------------------------------- */
         {
             mapped_type x = f();
@@ -1589,14 +3048,14 @@ int main() {
             STREAM << ( s >= s3 ) << std::endl;
             STREAM << ( s >= s4 ) << std::endl;
         }
-        /* -------------------------------- Benchmark ------------------------------- */
+        /* -------------------------------- Erase if -------------------------------- */
         {
-            set_type         m;
-            F< mapped_type > h;
+            set_type s;
 
-            for ( set_type::size_type i( 0 ); i < 1000000; i++ ) {
-                m.insert( h() );
-            }
+            for ( int i = 0; i < 300; i++ ) { s.insert( f() ); }
+
+            STREAM << erase_where( s, Multiple< 2 >() ) << std::endl;
+            STREAM << s << std::endl;
         }
         /* -------------------------------- Allocator ------------------------------- */
         {
@@ -2,19 +2,50 @@
 
 #include "algorithm.hpp"
 #include "iterator.hpp"
+#include "pool_allocator.hpp"
 #include "stack.hpp"
 #include "utility.hpp"
 #include <cstddef>
 #include <cstdlib>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <new>
+
+/* Build with -D FT_POOL_ALLOCATOR to default map and set to pooled nodes */
+#ifdef FT_POOL_ALLOCATOR
+#define FT_TREE_ALLOCATOR ft::pool_allocator
+#else
+#define FT_TREE_ALLOCATOR std::allocator
+#endif
 
 namespace ft {
 
+/* ---------------------------------- Value --------------------------------- */
+
+/* Elements are ( key, mapped ) pairs, or bare keys when V is void */
+template < typename K, typename V > struct _Rb_tree_value {
+    typedef ft::pair< const K, V > type;
+
+    template < typename P >
+    static const typename P::first_type &key( const P &value ) {
+        return value.first;
+    }
+};
+
+template < typename K > struct _Rb_tree_value< K, void > {
+    typedef K type;
+
+    static const K &key( const K &value ) { return value; }
+};
+
+/* --------------------------------- Rb tree -------------------------------- */
+
 template < typename K,
            typename V,
-           typename Comp      = std::less< K >,
-           typename Allocator = std::allocator< ft::pair< const K, V > > >
+           typename Comp = std::less< K >,
+           typename Allocator
+           = FT_TREE_ALLOCATOR< typename _Rb_tree_value< K, V >::type > >
 class _Rb_tree {
 
     /* ------------------------------ Member types ------------------------------ */
@@ -22,7 +53,7 @@ class _Rb_tree {
 public:
     typedef K                                        key_type;
     typedef V                                        mapped_type;
-    typedef ft::pair< const key_type, mapped_type >  value_type;
+    typedef typename _Rb_tree_value< K, V >::type    value_type;
     typedef Comp                                     key_compare;
     typedef Allocator                                allocator_type;
     typedef typename allocator_type::reference       reference;
@@ -35,7 +66,13 @@ public:
     /* ---------------------------------- Node ---------------------------------- */
 
 private:
-    struct _Node {
+    typedef _Rb_tree_value< K, V > value_traits;
+
+    static const key_type &_key( const value_type &value ) {
+        return value_traits::key( value );
+    }
+
+    struct _Node_base {
     private:
         enum {
             RED = 1 << 0,
@@ -45,20 +82,16 @@ private:
         u_int8_t _bits;
 
     public:
-        typedef typename Allocator::template rebind< _Node >::other
-                                                      node_allocator_type;
-        typedef typename node_allocator_type::pointer node_pointer;
+        typedef _Node_base *node_pointer;
 
-        pointer      data;
         node_pointer p;
         node_pointer left;
         node_pointer right;
 
     public:
-        _Node() : _bits( 0 ), data( 0 ), p( 0 ), left( 0 ), right( 0 ) {}
-        _Node( node_pointer left, node_pointer right )
+        _Node_base() : _bits( 0 ), p( 0 ), left( 0 ), right( 0 ) {}
+        _Node_base( node_pointer left, node_pointer right )
             : _bits( 0 ),
-              data( 0 ),
               p( 0 ),
               left( left ),
               right( right ) {}
@@ -67,29 +100,12 @@ private:
         bool is_nil() const { return _bits & NIL; }
         void set_red( bool is_red ) { _bits = ( _bits & NIL ) | is_red * RED; }
 
-        static _Node create_nil() {
-            _Node node;
+        static _Node_base create_nil() {
+            _Node_base node;
             node._bits = NIL;
             return node;
         }
 
-        node_pointer clone( node_allocator_type &allocator ) {
-            node_pointer node = allocator.allocate( 1 );
-            allocator.construct( node, *this );
-            return node;
-        }
-
-        static void destroy( node_pointer         node,
-                             node_allocator_type &allocator,
-                             allocator_type      &data_allocator ) {
-            if ( node->data ) {
-                data_allocator.destroy( node->data );
-                data_allocator.deallocate( node->data, 1 );
-            }
-            allocator.destroy( node );
-            allocator.deallocate( node, 1 );
-        }
-
         node_pointer min_child() {
             node_pointer node( this );
             while ( node->left && !node->left->is_nil() ) { node = node->left; }
@@ -104,9 +120,21 @@ private:
         }
     };
 
-    typedef _Node                               node_type;
-    typedef typename _Node::node_allocator_type node_allocator_type;
-    typedef typename _Node::node_pointer        node_pointer;
+    /* Element nodes carry their value inline, sentinels are bare links */
+    struct _Node : public _Node_base {
+        value_type data;
+
+        static value_type &value( _Node_base *node ) {
+            return static_cast< _Node * >( node )->data;
+        }
+    };
+
+    typedef _Node_base                        node_type;
+    typedef typename _Node_base::node_pointer node_pointer;
+    typedef typename Allocator::template rebind< _Node >::other
+        node_allocator_type;
+    typedef typename Allocator::template rebind< _Node_base >::other
+        sentinel_allocator_type;
 
     /* --------------------------------- Compare -------------------------------- */
 
@@ -128,12 +156,12 @@ private:
         bool operator()( const key_type &a, const node_pointer &b ) const {
             if ( b == _end ) { return true; }
             if ( b == _rend ) { return false; }
-            return _comp( a, b->data->first );
+            return _comp( a, _key( _Node::value( b ) ) );
         }
         bool operator()( const node_pointer &a, const key_type &b ) const {
             if ( a == _end ) { return false; }
             if ( a == _rend ) { return true; }
-            return _comp( a->data->first, b );
+            return _comp( _key( _Node::value( a ) ), b );
         }
         const key_compare &key_comp() const { return _comp; }
     };
@@ -202,8 +230,8 @@ private:
             return !( *this == other );
         }
 
-        reference operator*() const { return *_node->data; }
-        pointer   operator->() const { return _node->data; }
+        reference operator*() const { return _Node::value( _node ); }
+        pointer   operator->() const { return &_Node::value( _node ); }
 
         operator Iterator< const T >() const {
             return Iterator< const T >( _node );
@@ -212,8 +240,9 @@ private:
 
     /* --------------------------------- Members -------------------------------- */
 
-    node_allocator_type  _node_allocator;
-    allocator_type       _data_allocator;
+    node_allocator_type     _node_allocator;
+    sentinel_allocator_type _sentinel_allocator;
+    allocator_type          _data_allocator;
     node_pointer         _nil;
     node_pointer         _end;
     node_pointer         _rend;
@@ -227,10 +256,11 @@ public:
     _Rb_tree( const key_compare    &comp  = key_compare(),
               const allocator_type &alloc = allocator_type() )
         : _node_allocator( alloc ),
+          _sentinel_allocator( alloc ),
           _data_allocator( alloc ),
-          _nil( node_type::create_nil().clone( _node_allocator ) ),
-          _end( node_type( _nil, _nil ).clone( _node_allocator ) ),
-          _rend( node_type( _nil, _nil ).clone( _node_allocator ) ),
+          _nil( _create_sentinel( node_type::create_nil() ) ),
+          _end( _create_sentinel( node_type( _nil, _nil ) ) ),
+          _rend( _create_sentinel( node_type( _nil, _nil ) ) ),
           _root( _end ),
           _key_compare( extended_key_compare( _end, _rend, comp ) ),
           _size( 0 ) {
@@ -240,10 +270,11 @@ public:
     }
     _Rb_tree( const _Rb_tree &other )
         : _node_allocator( other._node_allocator ),
+          _sentinel_allocator( other._sentinel_allocator ),
           _data_allocator( other._data_allocator ),
-          _nil( node_type::create_nil().clone( _node_allocator ) ),
-          _end( node_type( _nil, _nil ).clone( _node_allocator ) ),
-          _rend( node_type( _nil, _nil ).clone( _node_allocator ) ),
+          _nil( _create_sentinel( node_type::create_nil() ) ),
+          _end( _create_sentinel( node_type( _nil, _nil ) ) ),
+          _rend( _create_sentinel( node_type( _nil, _nil ) ) ),
           _root( _end ),
           _key_compare( extended_key_compare( _end,
                                               _rend,
@@ -252,18 +283,23 @@ public:
         _root->left = _rend;
         _rend->set_red( true );
         _rend->p = _root;
-        insert( other.begin(), other.end() );
+        _copy( other );
     }
     _Rb_tree &operator=( const _Rb_tree &other ) {
-        clear();
-        insert( other.begin(), other.end() );
+        if ( this != &other ) {
+            _key_compare = extended_key_compare(
+                _end,
+                _rend,
+                other._key_compare.key_comp() );
+            _copy( other );
+        }
         return *this;
     }
     ~_Rb_tree() {
-        clear();
-        _Node::destroy( _nil, _node_allocator, _data_allocator );
-        _Node::destroy( _end, _node_allocator, _data_allocator );
-        _Node::destroy( _rend, _node_allocator, _data_allocator );
+        _erase_subtree( _root );
+        _destroy_sentinel( _nil );
+        _destroy_sentinel( _end );
+        _destroy_sentinel( _rend );
     }
 
     /* -------------------------------- Iterators ------------------------------- */
@@ -293,15 +329,41 @@ public:
         return _insert( data, _root );
     }
     ft::pair< iterator, bool > insert( iterator hint, const value_type &data ) {
-        if ( _is_upper_bound( data.first, hint.get_node() ) ) {
-            node_pointer node( hint.get_node() );
-            return _insert( data, node );
-        }
-        return insert( data );
+        return _insert_hint( data, hint.get_node() );
     }
+
+    /* Only build a value, default mapped one included, for a new key */
+    ft::pair< iterator, bool > try_emplace( const key_type &k ) {
+        node_pointer p( 0 );
+        node_pointer node( _find_or_parent( k, _root, p ) );
+        if ( node ) { return ft::make_pair( iterator( node ), false ); }
+        node = _insert_at( value_type( k, mapped_type() ),
+                           p,
+                           _key_compare( k, p ) );
+        return ft::make_pair( iterator( node ), true );
+    }
+    template < typename M >
+    ft::pair< iterator, bool > try_emplace( const key_type &k, const M &obj ) {
+        node_pointer p( 0 );
+        node_pointer node( _find_or_parent( k, _root, p ) );
+        if ( node ) { return ft::make_pair( iterator( node ), false ); }
+        node = _insert_at( value_type( k, obj ), p, _key_compare( k, p ) );
+        return ft::make_pair( iterator( node ), true );
+    }
+    template < typename M >
+    ft::pair< iterator, bool > insert_or_assign( const key_type &k,
+                                                 const M        &obj ) {
+        ft::pair< iterator, bool > res = try_emplace( k, obj );
+        if ( !res.second ) { res.first->second = obj; }
+        return res;
+    }
+
     template < class InputIterator >
     void insert( InputIterator first, InputIterator last ) {
-        for ( ; first != last; first++ ) { insert( *first ); }
+        _insert_range(
+            first,
+            last,
+            typename ft::iterator_traits< InputIterator >::iterator_category() );
     }
 
     size_type erase( const key_type &k ) { return _remove( _find_node( k ) ); }
@@ -314,6 +376,29 @@ public:
         }
     }
 
+    /*
+     * Erases the elements pred holds for, one _remove each. Once a sixteenth
+     * of them went and the victims outnumber the survivors eight to one,
+     * the survivors left are relinked into a balanced tree in O(n) instead.
+     */
+    template < typename Predicate > size_type erase_if( Predicate pred ) {
+        size_type n     = 0;
+        size_type kept  = 0;
+        size_type limit = _size / 16;
+        for ( iterator it = begin(); it != end(); ) {
+            if ( !pred( *it ) ) {
+                it++;
+                kept++;
+            } else if ( n >= limit && n / 8 > kept ) {
+                return n + _rebuild_if( it.get_node(), pred );
+            } else {
+                erase( it++ );
+                n++;
+            }
+        }
+        return n;
+    }
+
     void swap( _Rb_tree &other ) {
         ft::swap( _nil, other._nil );
         ft::swap( _end, other._end );
@@ -321,10 +406,15 @@ public:
         ft::swap( _root, other._root );
         ft::swap( _key_compare, other._key_compare );
         ft::swap( _node_allocator, other._node_allocator );
+        ft::swap( _sentinel_allocator, other._sentinel_allocator );
+        ft::swap( _data_allocator, other._data_allocator );
         ft::swap( _size, other._size );
     }
 
-    void clear() { erase( begin(), end() ); }
+    void clear() {
+        _erase_subtree( _root );
+        _reset();
+    }
 
     /* ------------------------------- Operations ------------------------------- */
 
@@ -339,6 +429,16 @@ public:
     const_iterator upper_bound( const key_type &k ) const {
         return _upper_bound( k );
     }
+    ft::pair< iterator, iterator > equal_range( const key_type &k ) {
+        ft::pair< node_pointer, node_pointer > range = _equal_range( k );
+        return ft::pair< iterator, iterator >( range.first, range.second );
+    }
+    ft::pair< const_iterator, const_iterator >
+    equal_range( const key_type &k ) const {
+        ft::pair< node_pointer, node_pointer > range = _equal_range( k );
+        return ft::pair< const_iterator, const_iterator >( range.first,
+                                                           range.second );
+    }
 
     /* -------------------------------- Allocator ------------------------------- */
 
@@ -370,6 +470,302 @@ public:
     /* --------------------------------- Helper --------------------------------- */
 
 private:
+    node_pointer _create_node( const value_type &data ) {
+        _Node *node = _node_allocator.allocate( 1 );
+        ::new ( static_cast< node_type * >( node ) ) node_type( _nil, _nil );
+        try {
+            _data_allocator.construct( &node->data, data );
+        } catch ( ... ) {
+            _node_allocator.deallocate( node, 1 );
+            throw;
+        }
+        return node;
+    }
+    void _destroy_node( node_pointer node ) {
+        _Node *value_node = static_cast< _Node * >( node );
+        _data_allocator.destroy( &value_node->data );
+        _node_allocator.deallocate( value_node, 1 );
+    }
+
+    node_pointer _create_sentinel( const node_type &node ) {
+        node_pointer sentinel = _sentinel_allocator.allocate( 1 );
+        _sentinel_allocator.construct( sentinel, node );
+        return sentinel;
+    }
+    void _destroy_sentinel( node_pointer sentinel ) {
+        _sentinel_allocator.destroy( sentinel );
+        _sentinel_allocator.deallocate( sentinel, 1 );
+    }
+
+    void _reset() {
+        _root = _end;
+        _end->p     = 0;
+        _end->left  = _rend;
+        _end->right = _nil;
+        _end->set_red( false );
+        _rend->p     = _end;
+        _rend->left  = _nil;
+        _rend->right = _nil;
+        _rend->set_red( true );
+        _size = 0;
+    }
+
+    /* Frees the element nodes below node, sentinels are left alone */
+    void _erase_subtree( node_pointer node ) {
+        if ( node->is_nil() ) { return; }
+        _erase_subtree( node->left );
+        _erase_subtree( node->right );
+        if ( node != _end && node != _rend ) { _destroy_node( node ); }
+    }
+
+    /* ---------------------------------- Copy ---------------------------------- */
+
+    /*
+     * Clones the shape and colours of other in O(n). Our current element
+     * nodes are recycled for the copy before any new one is allocated.
+     */
+    void _copy( const _Rb_tree &other ) {
+        node_pointer reuse( _nil );
+        _collect_nodes( _root, reuse );
+        _reset();
+        try {
+            _root = _clone( other._root, 0, other, reuse );
+        } catch ( ... ) {
+            _reset();
+            _free_nodes( reuse );
+            throw;
+        }
+        _free_nodes( reuse );
+        _size = other._size;
+    }
+
+    /* Chains the element nodes below node through their right link */
+    void _collect_nodes( node_pointer node, node_pointer &list ) {
+        if ( node->is_nil() ) { return; }
+        _collect_nodes( node->left, list );
+        _collect_nodes( node->right, list );
+        if ( node != _end && node != _rend ) {
+            node->right = list;
+            list        = node;
+        }
+    }
+
+    void _free_nodes( node_pointer list ) {
+        while ( !list->is_nil() ) {
+            node_pointer next( list->right );
+            _destroy_node( list );
+            list = next;
+        }
+    }
+
+    node_pointer _clone( node_pointer    src,
+                         node_pointer    p,
+                         const _Rb_tree &other,
+                         node_pointer   &reuse ) {
+        if ( src->is_nil() ) { return _nil; }
+        node_pointer node;
+        if ( src == other._end ) {
+            node = _end;
+        } else if ( src == other._rend ) {
+            node = _rend;
+        } else if ( !reuse->is_nil() ) {
+            node  = reuse;
+            reuse = reuse->right;
+            _Node *value_node = static_cast< _Node * >( node );
+            _data_allocator.destroy( &value_node->data );
+            try {
+                _data_allocator.construct( &value_node->data,
+                                           _Node::value( src ) );
+            } catch ( ... ) {
+                _node_allocator.deallocate( value_node, 1 );
+                throw;
+            }
+        } else {
+            node = _create_node( _Node::value( src ) );
+        }
+        node->p     = p;
+        node->left  = _nil;
+        node->right = _nil;
+        node->set_red( src->is_red() );
+        try {
+            node->left  = _clone( src->left, node, other, reuse );
+            node->right = _clone( src->right, node, other, reuse );
+        } catch ( ... ) {
+            _erase_subtree( node );
+            throw;
+        }
+        return node;
+    }
+
+    /* ------------------------------- Bulk build ------------------------------- */
+
+    template < class InputIterator >
+    void _insert_range( InputIterator first,
+                        InputIterator last,
+                        std::input_iterator_tag ) {
+        for ( ; first != last; first++ ) { insert( end(), *first ); }
+    }
+
+    /*
+     * Strictly sorted input into an empty tree is built directly as a
+     * balanced tree in O(n), anything else falls back to one insert each.
+     */
+    template < class ForwardIterator >
+    void _insert_range( ForwardIterator first,
+                        ForwardIterator last,
+                        std::forward_iterator_tag ) {
+        size_type n = 0;
+        if ( !_size && _is_sorted( first, last, n ) ) {
+            _build( first, n );
+        } else {
+            _insert_range( first, last, std::input_iterator_tag() );
+        }
+    }
+
+    template < class ForwardIterator >
+    bool
+    _is_sorted( ForwardIterator first, ForwardIterator last, size_type &n ) {
+        if ( first == last ) { return true; }
+        ForwardIterator prev( first );
+        for ( n = 1, first++; first != last; prev = first++, n++ ) {
+            if ( !_key_compare( value_traits::key( *prev ),
+                                value_traits::key( *first ) ) ) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /*
+     * Lays out _rend, the n values and _end in order, halving by size so
+     * every level but the deepest is full. Colouring that level red, when
+     * it is not full too, keeps all black heights equal.
+     */
+    template < class ForwardIterator >
+    void _build( ForwardIterator first, size_type n ) {
+        size_type depth = 0;
+        while ( ( size_type( 2 ) << depth ) <= n + 2 ) { depth++; }
+        if ( ( size_type( 2 ) << depth ) - 1 == n + 2 ) { depth++; }
+        try {
+            _root = _build( first, 0, n + 2, n + 1, 0, depth );
+        } catch ( ... ) {
+            _reset();
+            throw;
+        }
+        _root->p = 0;
+        _size    = n;
+    }
+
+    template < class ForwardIterator >
+    node_pointer _build( ForwardIterator &it,
+                         size_type        lo,
+                         size_type        hi,
+                         size_type        last,
+                         size_type        depth,
+                         size_type        red_depth ) {
+        if ( lo == hi ) { return _nil; }
+        size_type    mid  = lo + ( hi - lo ) / 2;
+        node_pointer left = _build( it, lo, mid, last, depth + 1, red_depth );
+        node_pointer node;
+        try {
+            node = mid == 0      ? _rend
+                   : mid == last ? _end
+                                 : _take( it );
+        } catch ( ... ) {
+            _erase_subtree( left );
+            throw;
+        }
+        node->left  = left;
+        node->right = _nil;
+        node->set_red( depth == red_depth );
+        if ( !left->is_nil() ) { left->p = node; }
+        try {
+            node->right = _build( it, mid + 1, hi, last, depth + 1, red_depth );
+        } catch ( ... ) {
+            _erase_subtree( node );
+            throw;
+        }
+        if ( !node->right->is_nil() ) { node->right->p = node; }
+        return node;
+    }
+
+    /* Element nodes chained through their right link, built as they are */
+    node_pointer _take( node_pointer &list ) {
+        node_pointer node( list );
+        list = list->right;
+        return node;
+    }
+
+    template < class ForwardIterator >
+    node_pointer _take( ForwardIterator &it ) {
+        return _create_node( *it++ );
+    }
+
+    /* -------------------------------- Erase if -------------------------------- */
+
+    /*
+     * first, known to go, and the nodes after it pred holds for are freed,
+     * the others are built back into a tree. Should pred throw, every node
+     * not freed yet stays.
+     */
+    template < typename Predicate >
+    size_type _rebuild_if( node_pointer first, Predicate &pred ) {
+        size_type     size = _size;
+        node_pointer  list( _nil );
+        node_pointer *tail = &list;
+        try {
+            _collect_if( _root, tail, first, pred );
+        } catch ( ... ) {
+            _relink( list, tail );
+            throw;
+        }
+        _relink( list, tail );
+        return size - _size;
+    }
+
+    /* In order, first cleared once reached and set to _nil to keep the rest */
+    template < typename Predicate >
+    void _collect_if( node_pointer   node,
+                      node_pointer *&tail,
+                      node_pointer  &first,
+                      Predicate     &pred ) {
+        if ( node->is_nil() ) { return; }
+        node_pointer right( node->right );
+        try {
+            _collect_if( node->left, tail, first, pred );
+            if ( node != _end && node != _rend
+                 && ( node == first
+                      || ( !first && pred( _Node::value( node ) ) ) ) ) {
+                first = 0;
+                _destroy_node( node );
+                _size--;
+                node = _nil;
+            }
+        } catch ( ... ) {
+            first = _nil;
+            _chain( node, tail );
+            _collect_if( right, tail, first, pred );
+            throw;
+        }
+        _chain( node, tail );
+        _collect_if( right, tail, first, pred );
+    }
+
+    void _chain( node_pointer node, node_pointer *&tail ) {
+        if ( node->is_nil() || node == _end || node == _rend ) { return; }
+        *tail = node;
+        tail  = &node->right;
+    }
+
+    void _relink( node_pointer list, node_pointer *tail ) {
+        size_type n = _size;
+        *tail       = _nil;
+        _reset();
+        _build( list, n );
+    }
+
+    /* --------------------------------- Search --------------------------------- */
+
     node_pointer _find_node( const key_type &k ) const {
         node_pointer current( _root );
         while ( !current->is_nil() ) {
@@ -385,44 +781,57 @@ private:
     }
 
     node_pointer _lower_bound( const key_type &k ) const {
-        node_pointer current( _root );
-        while ( !_is_lower_bound( current, k ) ) {
-            if ( _key_compare( k, current ) ) {
-                current = current->left;
-            } else {
+        return _lower_bound( k, _root, _end );
+    }
+    node_pointer _upper_bound( const key_type &k ) const {
+        return _upper_bound( k, _root, _end );
+    }
+
+    /* Bounds within the subtree of current, bound if it has none */
+    node_pointer _lower_bound( const key_type &k,
+                               node_pointer    current,
+                               node_pointer    bound ) const {
+        while ( !current->is_nil() ) {
+            if ( _key_compare( current, k ) ) {
                 current = current->right;
+            } else {
+                bound   = current;
+                current = current->left;
             }
         }
-        return current;
+        return bound;
     }
-    node_pointer _upper_bound( const key_type &k ) const {
-        node_pointer current( _root );
-        while ( !_is_upper_bound( current, k ) ) {
+    node_pointer _upper_bound( const key_type &k,
+                               node_pointer    current,
+                               node_pointer    bound ) const {
+        while ( !current->is_nil() ) {
             if ( _key_compare( k, current ) ) {
+                bound   = current;
                 current = current->left;
             } else {
                 current = current->right;
             }
         }
-        return current;
-    }
-
-    bool _is_lower_bound( node_pointer current, const key_type &k ) const {
-        node_pointer prev = ( --const_iterator( current ) ).get_node();
-        return ( current == begin().get_node() || _key_compare( prev, k ) )
-               && !_key_compare( current, k );
-    }
-    bool _is_upper_bound( node_pointer current, const key_type &k ) const {
-        node_pointer prev = ( --const_iterator( current ) ).get_node();
-        return ( current == begin().get_node() || !_key_compare( k, prev ) )
-               && _key_compare( k, current );
+        return bound;
     }
 
-    bool _is_upper_bound( const key_type &k, node_pointer current ) const {
-        if ( current == end().get_node() || _key_compare( k, current ) ) {
-            return false;
+    ft::pair< node_pointer, node_pointer >
+    _equal_range( const key_type &k ) const {
+        node_pointer current( _root );
+        node_pointer bound( _end );
+        while ( !current->is_nil() ) {
+            if ( _key_compare( current, k ) ) {
+                current = current->right;
+            } else if ( _key_compare( k, current ) ) {
+                bound   = current;
+                current = current->left;
+            } else {
+                return ft::make_pair(
+                    _lower_bound( k, current->left, current ),
+                    _upper_bound( k, current->right, bound ) );
+            }
         }
-        return _key_compare( k, ( ++const_iterator( current ) ).get_node() );
+        return ft::make_pair( bound, bound );
     }
 
     void _transplant( node_pointer u, node_pointer v ) {
@@ -517,7 +926,7 @@ private:
             }
             x->set_red( false );
         }
-        _Node::destroy( z, _node_allocator, _data_allocator );
+        _destroy_node( z );
         _size--;
         return 1;
     }
@@ -543,24 +952,66 @@ private:
     ft::pair< node_pointer, bool > _insert( const value_type &data,
                                             node_pointer      ancestor ) {
         node_pointer p( 0 );
+        node_pointer node( _find_or_parent( _key( data ), ancestor, p ) );
+        if ( node ) { return ft::make_pair( node, false ); }
+        return ft::make_pair(
+            _insert_at( data, p, _key_compare( _key( data ), p ) ),
+            true );
+    }
+
+    /* The node holding k below ancestor, or 0 and the parent k would get */
+    node_pointer _find_or_parent( const key_type &k,
+                                  node_pointer    ancestor,
+                                  node_pointer   &p ) const {
         while ( !ancestor->is_nil() ) {
             p = ancestor;
-            if ( _key_compare( data.first, ancestor ) ) {
+            if ( _key_compare( k, ancestor ) ) {
                 ancestor = ancestor->left;
-            } else if ( _key_compare( ancestor, data.first ) ) {
+            } else if ( _key_compare( ancestor, k ) ) {
                 ancestor = ancestor->right;
             } else {
-                return ft::make_pair( ancestor, false );
+                return ancestor;
             }
         }
-        node_pointer node( _Node( _nil, _nil ).clone( _node_allocator ) );
-        node->data = _data_allocator.allocate( 1 );
-        _data_allocator.construct( node->data, data );
+        return 0;
+    }
+
+    /*
+     * Inserts right before hint when the key fits between it and its
+     * predecessor, or right after it when it fits before its successor.
+     * Either neighbour has a free link on the shared side, so appending
+     * in order through end() is amortized O(1).
+     */
+    ft::pair< node_pointer, bool > _insert_hint( const value_type &data,
+                                                 node_pointer      hint ) {
+        if ( _key_compare( _key( data ), hint ) ) {
+            node_pointer prev( ( --iterator( hint ) ).get_node() );
+            if ( _key_compare( prev, _key( data ) ) ) {
+                node_pointer node
+                    = prev->right->is_nil() ? _insert_at( data, prev, false )
+                                            : _insert_at( data, hint, true );
+                return ft::make_pair( node, true );
+            }
+        } else if ( _key_compare( hint, _key( data ) ) ) {
+            node_pointer next( ( ++iterator( hint ) ).get_node() );
+            if ( _key_compare( _key( data ), next ) ) {
+                node_pointer node
+                    = hint->right->is_nil() ? _insert_at( data, hint, false )
+                                            : _insert_at( data, next, true );
+                return ft::make_pair( node, true );
+            }
+        } else {
+            return ft::make_pair( hint, false );
+        }
+        return _insert( data, _root );
+    }
+
+    node_pointer
+    _insert_at( const value_type &data, node_pointer p, bool left ) {
+        node_pointer node( _create_node( data ) );
         node->set_red( true );
         node->p = p;
-        if ( !p ) {
-            _root = node;
-        } else if ( _key_compare( data.first, p ) ) {
+        if ( left ) {
             p->left = node;
         } else {
             p->right = node;
@@ -601,7 +1052,7 @@ private:
         }
         _root->set_red( false );
         _size++;
-        return ft::make_pair( node, true );
+        return node;
     }
 };
 
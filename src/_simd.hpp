@@ -0,0 +1,449 @@
+#pragma once
+
+#include "type_traits.hpp"
+#include <cstddef>
+#include <cstring>
+
+/*
+ * Kernels over contiguous integral elements, picked at run time from what
+ * the CPU supports. Build with -D FT_SIMD=1 to stop at SSE2, or with
+ * -D FT_SIMD=0 to keep the scalar loops.
+ */
+#ifndef FT_SIMD
+#define FT_SIMD 2
+#endif
+
+#if FT_SIMD && defined( __GNUC__ )                                             \
+    && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define FT_SIMD_X86 1
+#include <immintrin.h>
+#define FT_SSE2 __attribute__( ( target( "sse2" ) ) )
+#define FT_AVX2 __attribute__( ( target( "avx2,popcnt" ) ) )
+#endif
+
+namespace ft {
+
+/* ---------------------------------- Level --------------------------------- */
+
+enum {
+    _SIMD_SCALAR,
+    _SIMD_SSE2,
+    _SIMD_AVX2,
+};
+
+inline int _simd_detect() {
+#ifdef FT_SIMD_X86
+    __builtin_cpu_init();
+    if ( FT_SIMD >= _SIMD_AVX2 && __builtin_cpu_supports( "avx2" ) ) {
+        return _SIMD_AVX2;
+    }
+    if ( __builtin_cpu_supports( "sse2" ) ) { return _SIMD_SSE2; }
+#endif
+    return _SIMD_SCALAR;
+}
+
+inline int _simd_level() {
+    static const int level = _simd_detect();
+    return level;
+}
+
+/* ---------------------------------- Lanes --------------------------------- */
+
+#ifdef FT_SIMD_X86
+FT_SSE2 inline __m128i _load128( const void *p ) {
+    return _mm_loadu_si128( static_cast< const __m128i * >( p ) );
+}
+FT_AVX2 inline __m256i _load( const void *p ) {
+    return _mm256_loadu_si256( static_cast< const __m256i * >( p ) );
+}
+
+/* Broadcast and compare for elements of Size bytes */
+template < std::size_t Size > struct _Lanes {};
+
+template <> struct _Lanes< 1 > {
+    typedef char bits;
+    FT_SSE2 static __m128i set1( bits x ) { return _mm_set1_epi8( x ); }
+    FT_SSE2 static __m128i eq( __m128i a, __m128i b ) {
+        return _mm_cmpeq_epi8( a, b );
+    }
+    FT_AVX2 static __m256i set1_256( bits x ) { return _mm256_set1_epi8( x ); }
+    FT_AVX2 static __m256i eq( __m256i a, __m256i b ) {
+        return _mm256_cmpeq_epi8( a, b );
+    }
+};
+
+template <> struct _Lanes< 2 > {
+    typedef short bits;
+    FT_SSE2 static __m128i set1( bits x ) { return _mm_set1_epi16( x ); }
+    FT_SSE2 static __m128i eq( __m128i a, __m128i b ) {
+        return _mm_cmpeq_epi16( a, b );
+    }
+    FT_AVX2 static __m256i set1_256( bits x ) {
+        return _mm256_set1_epi16( x );
+    }
+    FT_AVX2 static __m256i eq( __m256i a, __m256i b ) {
+        return _mm256_cmpeq_epi16( a, b );
+    }
+};
+
+template <> struct _Lanes< 4 > {
+    typedef int bits;
+    FT_SSE2 static __m128i set1( bits x ) { return _mm_set1_epi32( x ); }
+    FT_SSE2 static __m128i eq( __m128i a, __m128i b ) {
+        return _mm_cmpeq_epi32( a, b );
+    }
+    FT_AVX2 static __m256i set1_256( bits x ) {
+        return _mm256_set1_epi32( x );
+    }
+    FT_AVX2 static __m256i eq( __m256i a, __m256i b ) {
+        return _mm256_cmpeq_epi32( a, b );
+    }
+};
+
+/* SSE2 has no 64 bit compare, both 32 bit halves have to match */
+template <> struct _Lanes< 8 > {
+    typedef long long bits;
+    FT_SSE2 static __m128i set1( bits x ) { return _mm_set1_epi64x( x ); }
+    FT_SSE2 static __m128i eq( __m128i a, __m128i b ) {
+        __m128i e = _mm_cmpeq_epi32( a, b );
+        return _mm_and_si128( e, _mm_shuffle_epi32( e, 0xb1 ) );
+    }
+    FT_AVX2 static __m256i set1_256( bits x ) {
+        return _mm256_set1_epi64x( x );
+    }
+    FT_AVX2 static __m256i eq( __m256i a, __m256i b ) {
+        return _mm256_cmpeq_epi64( a, b );
+    }
+};
+
+/* Signed or unsigned min and max, AVX2 has them up to 32 bits */
+template < typename T > struct _Order {};
+
+template <> struct _Order< signed char > {
+    FT_AVX2 static __m256i min( __m256i a, __m256i b ) {
+        return _mm256_min_epi8( a, b );
+    }
+    FT_AVX2 static __m256i max( __m256i a, __m256i b ) {
+        return _mm256_max_epi8( a, b );
+    }
+};
+
+template <> struct _Order< unsigned char > {
+    FT_AVX2 static __m256i min( __m256i a, __m256i b ) {
+        return _mm256_min_epu8( a, b );
+    }
+    FT_AVX2 static __m256i max( __m256i a, __m256i b ) {
+        return _mm256_max_epu8( a, b );
+    }
+};
+
+template <> struct _Order< short > {
+    FT_AVX2 static __m256i min( __m256i a, __m256i b ) {
+        return _mm256_min_epi16( a, b );
+    }
+    FT_AVX2 static __m256i max( __m256i a, __m256i b ) {
+        return _mm256_max_epi16( a, b );
+    }
+};
+
+template <> struct _Order< unsigned short > {
+    FT_AVX2 static __m256i min( __m256i a, __m256i b ) {
+        return _mm256_min_epu16( a, b );
+    }
+    FT_AVX2 static __m256i max( __m256i a, __m256i b ) {
+        return _mm256_max_epu16( a, b );
+    }
+};
+
+template <> struct _Order< int > {
+    FT_AVX2 static __m256i min( __m256i a, __m256i b ) {
+        return _mm256_min_epi32( a, b );
+    }
+    FT_AVX2 static __m256i max( __m256i a, __m256i b ) {
+        return _mm256_max_epi32( a, b );
+    }
+};
+
+template <> struct _Order< unsigned int > {
+    FT_AVX2 static __m256i min( __m256i a, __m256i b ) {
+        return _mm256_min_epu32( a, b );
+    }
+    FT_AVX2 static __m256i max( __m256i a, __m256i b ) {
+        return _mm256_max_epu32( a, b );
+    }
+};
+
+template < bool Signed > struct _Plain_char : public _Order< signed char > {};
+
+template <> struct _Plain_char< false > : public _Order< unsigned char > {};
+
+template <>
+struct _Order< char >
+    : public _Plain_char< ( static_cast< char >( -1 ) < 0 ) > {};
+#endif
+
+/* Types _Order has min and max for */
+template < typename T > struct _Has_order : public false_type {};
+
+#ifdef FT_SIMD_X86
+template <> struct _Has_order< char > : public true_type {};
+
+template <> struct _Has_order< signed char > : public true_type {};
+
+template <> struct _Has_order< unsigned char > : public true_type {};
+
+template <> struct _Has_order< short > : public true_type {};
+
+template <> struct _Has_order< unsigned short > : public true_type {};
+
+template <> struct _Has_order< int > : public true_type {};
+
+template <> struct _Has_order< unsigned int > : public true_type {};
+#endif
+
+/* -------------------------------- Mismatch -------------------------------- */
+
+#ifdef FT_SIMD_X86
+FT_AVX2 inline std::size_t _mismatch_avx2( const unsigned char *a,
+                                           const unsigned char *b,
+                                           std::size_t          n ) {
+    std::size_t i = 0;
+    for ( ; i + 32 <= n; i += 32 ) {
+        __m256i  x = _load( a + i );
+        __m256i  y = _load( b + i );
+        unsigned m = ~static_cast< unsigned >(
+            _mm256_movemask_epi8( _mm256_cmpeq_epi8( x, y ) ) );
+        if ( m ) { return i + __builtin_ctz( m ); }
+    }
+    for ( ; i < n && a[i] == b[i]; i++ ) {}
+    return i;
+}
+
+FT_SSE2 inline std::size_t _mismatch_sse2( const unsigned char *a,
+                                           const unsigned char *b,
+                                           std::size_t          n ) {
+    std::size_t i = 0;
+    for ( ; i + 16 <= n; i += 16 ) {
+        __m128i  x = _load128( a + i );
+        __m128i  y = _load128( b + i );
+        unsigned m = 0xffff
+                     & ~static_cast< unsigned >(
+                         _mm_movemask_epi8( _mm_cmpeq_epi8( x, y ) ) );
+        if ( m ) { return i + __builtin_ctz( m ); }
+    }
+    for ( ; i < n && a[i] == b[i]; i++ ) {}
+    return i;
+}
+#endif
+
+/* Index of the first byte that differs, n when none does */
+inline std::size_t
+_simd_mismatch( const void *a, const void *b, std::size_t n ) {
+    const unsigned char *x = static_cast< const unsigned char * >( a );
+    const unsigned char *y = static_cast< const unsigned char * >( b );
+#ifdef FT_SIMD_X86
+    switch ( _simd_level() ) {
+    case _SIMD_AVX2: return _mismatch_avx2( x, y, n );
+    case _SIMD_SSE2: return _mismatch_sse2( x, y, n );
+    }
+#endif
+    std::size_t i = 0;
+    for ( ; i < n && x[i] == y[i]; i++ ) {}
+    return i;
+}
+
+/* ---------------------------------- Find ---------------------------------- */
+
+#ifdef FT_SIMD_X86
+template < typename T >
+FT_AVX2 std::size_t _find_avx2( const T *p, std::size_t n, T value ) {
+    typedef _Lanes< sizeof( T ) > lanes;
+    typename lanes::bits          bits;
+    std::memcpy( &bits, &value, sizeof( T ) );
+    const std::size_t step = 32 / sizeof( T );
+    __m256i           v    = lanes::set1_256( bits );
+    std::size_t       i    = 0;
+    for ( ; i + step <= n; i += step ) {
+        __m256i  x = _load( p + i );
+        unsigned m = _mm256_movemask_epi8( lanes::eq( x, v ) );
+        if ( m ) { return i + __builtin_ctz( m ) / sizeof( T ); }
+    }
+    for ( ; i < n && !( p[i] == value ); i++ ) {}
+    return i;
+}
+
+template < typename T >
+FT_SSE2 std::size_t _find_sse2( const T *p, std::size_t n, T value ) {
+    typedef _Lanes< sizeof( T ) > lanes;
+    typename lanes::bits          bits;
+    std::memcpy( &bits, &value, sizeof( T ) );
+    const std::size_t step = 16 / sizeof( T );
+    __m128i           v    = lanes::set1( bits );
+    std::size_t       i    = 0;
+    for ( ; i + step <= n; i += step ) {
+        __m128i  x = _load128( p + i );
+        unsigned m = _mm_movemask_epi8( lanes::eq( x, v ) );
+        if ( m ) { return i + __builtin_ctz( m ) / sizeof( T ); }
+    }
+    for ( ; i < n && !( p[i] == value ); i++ ) {}
+    return i;
+}
+#endif
+
+/* Index of the first element equal to value, n when none is */
+template < typename T >
+std::size_t _simd_find( const T *p, std::size_t n, T value ) {
+#ifdef FT_SIMD_X86
+    switch ( _simd_level() ) {
+    case _SIMD_AVX2: return _find_avx2( p, n, value );
+    case _SIMD_SSE2: return _find_sse2( p, n, value );
+    }
+#endif
+    std::size_t i = 0;
+    for ( ; i < n && !( p[i] == value ); i++ ) {}
+    return i;
+}
+
+/* ---------------------------------- Count --------------------------------- */
+
+#ifdef FT_SIMD_X86
+template < typename T >
+FT_AVX2 std::size_t _count_avx2( const T *p, std::size_t n, T value ) {
+    typedef _Lanes< sizeof( T ) > lanes;
+    typename lanes::bits          bits;
+    std::memcpy( &bits, &value, sizeof( T ) );
+    const std::size_t step  = 32 / sizeof( T );
+    __m256i           v     = lanes::set1_256( bits );
+    std::size_t       bytes = 0;
+    std::size_t       i     = 0;
+    for ( ; i + step <= n; i += step ) {
+        __m256i x = _load( p + i );
+        bytes
+            += __builtin_popcount( _mm256_movemask_epi8( lanes::eq( x, v ) ) );
+    }
+    std::size_t count = bytes / sizeof( T );
+    for ( ; i < n; i++ ) { count += p[i] == value; }
+    return count;
+}
+
+template < typename T >
+FT_SSE2 std::size_t _count_sse2( const T *p, std::size_t n, T value ) {
+    typedef _Lanes< sizeof( T ) > lanes;
+    typename lanes::bits          bits;
+    std::memcpy( &bits, &value, sizeof( T ) );
+    const std::size_t step  = 16 / sizeof( T );
+    __m128i           v     = lanes::set1( bits );
+    std::size_t       bytes = 0;
+    std::size_t       i     = 0;
+    for ( ; i + step <= n; i += step ) {
+        __m128i x = _load128( p + i );
+        bytes += __builtin_popcount( _mm_movemask_epi8( lanes::eq( x, v ) ) );
+    }
+    std::size_t count = bytes / sizeof( T );
+    for ( ; i < n; i++ ) { count += p[i] == value; }
+    return count;
+}
+#endif
+
+template < typename T >
+std::size_t _simd_count( const T *p, std::size_t n, T value ) {
+#ifdef FT_SIMD_X86
+    switch ( _simd_level() ) {
+    case _SIMD_AVX2: return _count_avx2( p, n, value );
+    case _SIMD_SSE2: return _count_sse2( p, n, value );
+    }
+#endif
+    std::size_t count = 0;
+    for ( std::size_t i = 0; i < n; i++ ) { count += p[i] == value; }
+    return count;
+}
+
+/* --------------------------------- Min max -------------------------------- */
+
+#ifdef FT_SIMD_X86
+/* The smallest, or with Max the largest, of n > 0 elements */
+template < bool Max, typename T >
+FT_AVX2 T _extremum_avx2( const T *p, std::size_t n ) {
+    const std::size_t step = 32 / sizeof( T );
+    T                 best = p[0];
+    std::size_t       i    = 0;
+    if ( n >= step ) {
+        __m256i acc = _load( p );
+        for ( i = step; i + step <= n; i += step ) {
+            __m256i x = _load( p + i );
+            acc       = Max ? _Order< T >::max( acc, x )
+                            : _Order< T >::min( acc, x );
+        }
+        T lanes[32 / sizeof( T )];
+        _mm256_storeu_si256( reinterpret_cast< __m256i * >( lanes ), acc );
+        for ( std::size_t j = 0; j < step; j++ ) {
+            if ( Max ? best < lanes[j] : lanes[j] < best ) { best = lanes[j]; }
+        }
+    }
+    for ( ; i < n; i++ ) {
+        if ( Max ? best < p[i] : p[i] < best ) { best = p[i]; }
+    }
+    return best;
+}
+#endif
+
+template < bool Max, typename T >
+std::size_t _simd_extremum( const T *p, std::size_t n, true_type ) {
+#ifdef FT_SIMD_X86
+    if ( _simd_level() == _SIMD_AVX2 ) {
+        return _simd_find( p, n, _extremum_avx2< Max >( p, n ) );
+    }
+#endif
+    return _simd_extremum< Max >( p, n, false_type() );
+}
+
+template < bool Max, typename T >
+std::size_t _simd_extremum( const T *p, std::size_t n, false_type ) {
+    std::size_t best = 0;
+    for ( std::size_t i = 1; i < n; i++ ) {
+        if ( Max ? p[best] < p[i] : p[i] < p[best] ) { best = i; }
+    }
+    return best;
+}
+
+/* Index of the first smallest, or with Max largest, of n > 0 elements */
+template < bool Max, typename T >
+std::size_t _simd_extremum( const T *p, std::size_t n ) {
+    return _simd_extremum< Max >( p, n, _Has_order< T >() );
+}
+
+/* ---------------------------------- Fill ---------------------------------- */
+
+#ifdef FT_SIMD_X86
+template < typename T >
+FT_AVX2 void _fill_avx2( T *p, std::size_t n, T value ) {
+    typedef _Lanes< sizeof( T ) > lanes;
+    typename lanes::bits          bits;
+    std::memcpy( &bits, &value, sizeof( T ) );
+    const std::size_t step = 32 / sizeof( T );
+    __m256i           v    = lanes::set1_256( bits );
+    std::size_t       i    = 0;
+    for ( ; i + step <= n; i += step ) {
+        _mm256_storeu_si256( reinterpret_cast< __m256i * >( p + i ), v );
+    }
+    for ( ; i < n; i++ ) { p[i] = value; }
+}
+#endif
+
+template < typename T > void _simd_fill( T *p, std::size_t n, T value ) {
+    if ( sizeof( T ) == 1 ) {
+        std::memset( p, static_cast< unsigned char >( value ), n );
+        return;
+    }
+#ifdef FT_SIMD_X86
+    if ( _simd_level() == _SIMD_AVX2 ) {
+        _fill_avx2( p, n, value );
+        return;
+    }
+#endif
+    for ( std::size_t i = 0; i < n; i++ ) { p[i] = value; }
+}
+
+/* -------------------------------------------------------------------------- */
+
+}
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "algorithm.hpp"
 #include "iterator.hpp"
+#include "type_traits.hpp"
+#include <cstring>
 #include <memory>
+#include <utility>
 
 namespace ft {
 
@@ -26,6 +30,28 @@ inline ForwardIterator _uninitialized_copy_a( InputIterator   first,
     return std::uninitialized_copy( first, last, dst );
 }
 
+/* ---------------------------------- Move ---------------------------------- */
+
+/* Relocation source, moved from when that cannot throw (C++11 and later) */
+template < typename T, typename ForwardIterator, typename Alloc >
+ForwardIterator
+_uninitialized_move_if_noexcept_a( T              *first,
+                                   T              *last,
+                                   ForwardIterator dst,
+                                   Alloc          &allocator ) {
+#if __cplusplus >= 201103L
+    for ( ; first != last; first++, dst++ ) {
+        std::allocator_traits< Alloc >::construct( allocator,
+                                                   &( *dst ),
+                                                   std::move_if_noexcept(
+                                                       *first ) );
+    }
+    return dst;
+#else
+    return ft::_uninitialized_copy_a( first, last, dst, allocator );
+#endif
+}
+
 /* ---------------------------------- Fill ---------------------------------- */
 
 template < typename ForwardIterator, typename T, typename A >
@@ -36,12 +62,29 @@ void _uninitialized_fill_a( ForwardIterator first,
     for ( ; first != last; first++ ) { allocator.construct( &( *first ), x ); }
 }
 
+template < typename ForwardIterator, typename T >
+void _uninitialized_fill( ForwardIterator first,
+                          ForwardIterator last,
+                          const T        &x,
+                          false_type ) {
+    std::uninitialized_fill( first, last, x );
+}
+
+/* Trivial copies are assignments, which ft::fill vectorizes */
+template < typename ForwardIterator, typename T >
+void _uninitialized_fill( ForwardIterator first,
+                          ForwardIterator last,
+                          const T        &x,
+                          true_type ) {
+    ft::fill( first, last, x );
+}
+
 template < typename ForwardIterator, typename T, typename U >
 void _uninitialized_fill_a( ForwardIterator first,
                             ForwardIterator last,
                             const T        &x,
                             std::allocator< U > & ) {
-    return std::uninitialized_fill( first, last, x );
+    _uninitialized_fill( first, last, x, is_trivially_copyable< U >() );
 }
 
 /* --------------------------------- Destroy -------------------------------- */
@@ -82,6 +125,74 @@ _destroy( ForwardIterator first, ForwardIterator last, std::allocator< T > & ) {
     _destroy( first, last );
 }
 
+/* --------------------------------- Default -------------------------------- */
+
+/*
+ * Default-initialization, which leaves trivial types as the memory was. The
+ * allocator has no construct for it, elements are built by placement new.
+ */
+template < bool > struct _Default_aux {
+    template < typename T > static void _construct( T *first, T *last ) {
+        T *p = first;
+        try {
+            for ( ; p != last; p++ ) { ::new ( static_cast< void * >( p ) ) T; }
+        } catch ( ... ) {
+            ft::_destroy( first, p );
+            throw;
+        }
+    }
+};
+
+template <> struct _Default_aux< true > {
+    template < typename T > static void _construct( T *, T * ) {}
+};
+
+template < typename T >
+inline void _uninitialized_default( T *first, T *last ) {
+#ifdef __GNUG__
+    _Default_aux< __has_trivial_constructor( T ) >::_construct( first, last );
+#else
+    _Default_aux< false >::_construct( first, last );
+#endif
+}
+
+/* -------------------------------- Relocate -------------------------------- */
+
+/* Byte copy of trivially relocatable objects, ranges may overlap */
+template < typename T > inline T *_relocate_bytes( T *first, T *last, T *dst ) {
+    if ( first == last ) { return dst; }
+    std::memmove( static_cast< void * >( dst ),
+                  static_cast< const void * >( first ),
+                  ( last - first ) * sizeof( T ) );
+    return dst + ( last - first );
+}
+
+template < bool > struct _Relocate_aux {
+    template < typename T, typename Alloc >
+    static T *_relocate( T *first, T *last, T *dst, Alloc &allocator ) {
+        T *res = ft::_uninitialized_move_if_noexcept_a( first,
+                                                        last,
+                                                        dst,
+                                                        allocator );
+        ft::_destroy( first, last, allocator );
+        return res;
+    }
+};
+
+template <> struct _Relocate_aux< true > {
+    template < typename T, typename Alloc >
+    static T *_relocate( T *first, T *last, T *dst, Alloc & ) {
+        return ft::_relocate_bytes( first, last, dst );
+    }
+};
+
+/* Moves [first, last) to uninitialized dst, leaving it uninitialized */
+template < typename T, typename Alloc >
+inline T *_relocate_a( T *first, T *last, T *dst, Alloc &allocator ) {
+    return _Relocate_aux< ft::is_trivially_relocatable< T >::value >::
+        _relocate( first, last, dst, allocator );
+}
+
 /* -------------------------------------------------------------------------- */
 
 }
\ No newline at end of file
@@ -1,5 +1,11 @@
 #pragma once
 
+#include "_simd.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include <cstddef>
+#include <cstring>
+
 namespace ft {
 
 /* ---------------------------------- Swap ---------------------------------- */
@@ -10,20 +16,66 @@ template < typename T > void swap( T &a, T &b ) {
     b = tmp;
 }
 
+/* ---------------------------------- Simd ---------------------------------- */
+
+/*
+ * Contiguous ranges of one integral type, and values of that same type,
+ * go through the kernels of _simd.hpp. Anything else takes the loops.
+ */
+template < typename I1, typename I2 = I1, typename V = void >
+struct _Simd_range {
+    typedef typename remove_const<
+        typename iterator_traits< I1 >::value_type >::type value_type;
+    typedef typename remove_const<
+        typename iterator_traits< I2 >::value_type >::type other_type;
+
+    static const bool value
+        = is_contiguous_iterator< I1 >::value
+          && is_contiguous_iterator< I2 >::value
+          && is_integral< value_type >::value
+          && is_same< value_type, other_type >::value
+          && ( is_same< V, void >::value || is_same< V, value_type >::value );
+
+    typedef integral_constant< bool, value > type;
+};
+
+template < typename I >
+const typename iterator_traits< I >::value_type *_address( I it ) {
+    return &*it;
+}
+
 /* ---------------------------------- Equal --------------------------------- */
 
 template < typename T1, typename T2 >
-bool equal( T1 first1, T1 last1, T2 first2 ) {
+bool _equal( T1 first1, T1 last1, T2 first2, false_type ) {
     for ( ; first1 != last1; first1++, first2++ ) {
         if ( !( *first1 == *first2 ) ) { return false; }
     }
     return true;
 }
 
+template < typename T1, typename T2 >
+bool _equal( T1 first1, T1 last1, T2 first2, true_type ) {
+    std::size_t n = ( last1 - first1 ) * sizeof( *first1 );
+    return !n || _simd_mismatch( &*first1, &*first2, n ) == n;
+}
+
+template < typename T1, typename T2 >
+bool equal( T1 first1, T1 last1, T2 first2 ) {
+    return _equal( first1,
+                   last1,
+                   first2,
+                   typename _Simd_range< T1, T2 >::type() );
+}
+
 /* ------------------------- Lexicographical compare ------------------------ */
 
 template < typename T1, typename T2 >
-bool lexicographical_compare( T1 first1, T1 last1, T2 first2, T2 last2 ) {
+bool _lexicographical_compare( T1 first1,
+                               T1 last1,
+                               T2 first2,
+                               T2 last2,
+                               false_type ) {
     for ( ; first1 != last1; first1++, first2++ ) {
         if ( first2 == last2 || *first2 < *first1 ) { return false; }
         if ( *first1 < *first2 ) { return true; }
@@ -31,6 +83,180 @@ bool lexicographical_compare( T1 first1, T1 last1, T2 first2, T2 last2 ) {
     return first2 != last2;
 }
 
+/* The first differing byte lies in the first differing element */
+template < typename T1, typename T2 >
+bool _lexicographical_compare( T1 first1,
+                               T1 last1,
+                               T2 first2,
+                               T2 last2,
+                               true_type ) {
+    std::size_t n1 = last1 - first1;
+    std::size_t n2 = last2 - first2;
+    std::size_t n  = n1 < n2 ? n1 : n2;
+    if ( !n ) { return n1 < n2; }
+    std::size_t size = sizeof( *first1 );
+    std::size_t i    = _simd_mismatch( &*first1, &*first2, n * size ) / size;
+    if ( i < n ) { return first1[i] < first2[i]; }
+    return n1 < n2;
+}
+
+template < typename T1, typename T2 >
+bool lexicographical_compare( T1 first1, T1 last1, T2 first2, T2 last2 ) {
+    return _lexicographical_compare( first1,
+                                     last1,
+                                     first2,
+                                     last2,
+                                     typename _Simd_range< T1, T2 >::type() );
+}
+
+/* ---------------------------------- Find ---------------------------------- */
+
+template < typename InputIterator, typename T >
+InputIterator
+_find( InputIterator first, InputIterator last, const T &value, false_type ) {
+    for ( ; first != last && !( *first == value ); first++ ) {}
+    return first;
+}
+
+template < typename InputIterator, typename T >
+InputIterator
+_find( InputIterator first, InputIterator last, const T &value, true_type ) {
+    if ( first == last ) { return last; }
+    return first + _simd_find( _address( first ), last - first, value );
+}
+
+template < typename InputIterator, typename T >
+InputIterator find( InputIterator first, InputIterator last, const T &value ) {
+    return _find(
+        first,
+        last,
+        value,
+        typename _Simd_range< InputIterator, InputIterator, T >::type() );
+}
+
+/* ---------------------------------- Count --------------------------------- */
+
+template < typename InputIterator, typename T >
+typename iterator_traits< InputIterator >::difference_type
+_count( InputIterator first, InputIterator last, const T &value, false_type ) {
+    typename iterator_traits< InputIterator >::difference_type n = 0;
+    for ( ; first != last; first++ ) {
+        if ( *first == value ) { n++; }
+    }
+    return n;
+}
+
+template < typename InputIterator, typename T >
+typename iterator_traits< InputIterator >::difference_type
+_count( InputIterator first, InputIterator last, const T &value, true_type ) {
+    if ( first == last ) { return 0; }
+    return _simd_count( _address( first ), last - first, value );
+}
+
+template < typename InputIterator, typename T >
+typename iterator_traits< InputIterator >::difference_type
+count( InputIterator first, InputIterator last, const T &value ) {
+    return _count(
+        first,
+        last,
+        value,
+        typename _Simd_range< InputIterator, InputIterator, T >::type() );
+}
+
+/* --------------------------------- Min max -------------------------------- */
+
+template < bool Max, typename ForwardIterator >
+ForwardIterator
+_extremum( ForwardIterator first, ForwardIterator last, false_type ) {
+    if ( first == last ) { return last; }
+    ForwardIterator best( first );
+    for ( first++; first != last; first++ ) {
+        if ( Max ? *best < *first : *first < *best ) { best = first; }
+    }
+    return best;
+}
+
+template < bool Max, typename ForwardIterator >
+ForwardIterator
+_extremum( ForwardIterator first, ForwardIterator last, true_type ) {
+    if ( first == last ) { return last; }
+    return first + _simd_extremum< Max >( _address( first ), last - first );
+}
+
+template < typename ForwardIterator >
+ForwardIterator min_element( ForwardIterator first, ForwardIterator last ) {
+    return _extremum< false >(
+        first,
+        last,
+        typename _Simd_range< ForwardIterator >::type() );
+}
+
+template < typename ForwardIterator >
+ForwardIterator max_element( ForwardIterator first, ForwardIterator last ) {
+    return _extremum< true >(
+        first,
+        last,
+        typename _Simd_range< ForwardIterator >::type() );
+}
+
+/* ---------------------------------- Fill ---------------------------------- */
+
+template < typename ForwardIterator, typename T >
+void _fill( ForwardIterator first,
+            ForwardIterator last,
+            const T        &value,
+            false_type ) {
+    for ( ; first != last; first++ ) { *first = value; }
+}
+
+template < typename ForwardIterator, typename T >
+void _fill( ForwardIterator first,
+            ForwardIterator last,
+            const T        &value,
+            true_type ) {
+    typedef typename iterator_traits< ForwardIterator >::value_type value_type;
+    if ( first == last ) { return; }
+    _simd_fill( &*first, last - first, value_type( value ) );
+}
+
+/* value is converted once, as assigning it to each element would */
+template < typename ForwardIterator, typename T >
+void fill( ForwardIterator first, ForwardIterator last, const T &value ) {
+    _fill( first,
+           last,
+           value,
+           typename _Simd_range< ForwardIterator >::type() );
+}
+
+/* ---------------------------------- Copy ---------------------------------- */
+
+template < typename InputIterator, typename OutputIterator >
+OutputIterator _copy( InputIterator  first,
+                      InputIterator  last,
+                      OutputIterator dst,
+                      false_type ) {
+    for ( ; first != last; first++, dst++ ) { *dst = *first; }
+    return dst;
+}
+
+/* memmove, which libc already dispatches on the CPU */
+template < typename InputIterator, typename OutputIterator >
+OutputIterator _copy( InputIterator  first,
+                      InputIterator  last,
+                      OutputIterator dst,
+                      true_type ) {
+    std::size_t n = last - first;
+    if ( n ) { std::memmove( &*dst, &*first, n * sizeof( *first ) ); }
+    return dst + n;
+}
+
+template < typename InputIterator, typename OutputIterator >
+OutputIterator
+copy( InputIterator first, InputIterator last, OutputIterator dst ) {
+    typedef _Simd_range< InputIterator, OutputIterator > simd;
+    return _copy( first, last, dst, typename simd::type() );
+}
+
 /* -------------------------------------------------------------------------- */
 
 }
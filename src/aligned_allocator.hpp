@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace ft {
+
+/* -------------------------------- Allocator ------------------------------- */
+
+/*
+ * Buffers start on an Align byte boundary, 32 for full AVX2 loads and 64 to
+ * own their first cache line. Align has to be a power of two at least the
+ * size of a pointer.
+ */
+template < typename T, std::size_t Align = 64 > class aligned_allocator {
+public:
+    typedef T                 value_type;
+    typedef value_type       *pointer;
+    typedef const value_type *const_pointer;
+    typedef value_type       &reference;
+    typedef const value_type &const_reference;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+
+    template < typename U > struct rebind {
+        typedef aligned_allocator< U, Align > other;
+    };
+
+    aligned_allocator() throw() {}
+    template < typename U >
+    aligned_allocator( const aligned_allocator< U, Align > & ) throw() {}
+
+    /*
+     * Align bytes more than asked from operator new, the block it returned
+     * stored right before the aligned address. posix_memalign would split
+     * its leading and trailing slack off malloc's heap, which then fails to
+     * reuse the freed large blocks.
+     */
+    pointer allocate( size_type n, const void * = 0 ) {
+        if ( n > max_size() ) { throw std::bad_alloc(); }
+        std::size_t size  = n * sizeof( T ) + Align;
+        char       *block = static_cast< char * >( ::operator new( size ) );
+        void      **p     = reinterpret_cast< void ** >(
+            block + Align - std::size_t( block ) % Align );
+        p[-1] = block;
+        return reinterpret_cast< pointer >( p );
+    }
+
+    void deallocate( pointer p, size_type ) {
+        ::operator delete( reinterpret_cast< void ** >( p )[-1] );
+    }
+
+    void construct( pointer p, const_reference val ) {
+        ::new ( static_cast< void * >( p ) ) value_type( val );
+    }
+    void destroy( pointer p ) { p->~value_type(); }
+
+    size_type max_size() const throw() {
+        return ( std::numeric_limits< size_type >::max() - Align )
+               / sizeof( T );
+    }
+    pointer       address( reference x ) const { return &x; }
+    const_pointer address( const_reference x ) const { return &x; }
+};
+
+template < typename T, typename U, std::size_t N >
+bool operator==( const aligned_allocator< T, N > &,
+                 const aligned_allocator< U, N > & ) {
+    return true;
+}
+template < typename T, typename U, std::size_t N >
+bool operator!=( const aligned_allocator< T, N > &,
+                 const aligned_allocator< U, N > & ) {
+    return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+}
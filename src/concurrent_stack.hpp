@@ -0,0 +1,301 @@
+#pragma once
+
+#include "utility.hpp"
+#include <cstddef>
+#include <memory>
+#include <stdint.h>
+
+namespace ft {
+
+/* ---------------------------- Concurrent stack ---------------------------- */
+
+/*
+ * A stack any number of threads can push to and pop from at once, without
+ * locks: Treiber's, the top swapped in by compare-and-swap. Under heavy
+ * contention a push that loses the race parks its node in one of a few
+ * elimination slots for a while, a pop that loses takes one from there:
+ * the pair cancels out without touching the top.
+ *
+ * pop hands the element out, top then pop could see another thread's pop
+ * in between. Nodes are recycled through a free list of their own and go
+ * back to the allocator only with the stack, so a thread that lost a race
+ * still reads a live node. Every pointer that can change, the top, the
+ * free list and the slots, carries a tag bumped on each write, in the
+ * bits a user space pointer leaves unused: a compare-and-swap after the
+ * node left and came back sees a new tag, not the same pointer (ABA).
+ */
+template < typename T, typename Allocator = std::allocator< T > >
+class concurrent_stack {
+
+    /* ---------------------------------- Node ---------------------------------- */
+
+    struct _Node {
+        T      value;
+        _Node *next;
+    };
+
+    typedef typename Allocator::template rebind< _Node >::other
+        _Node_allocator;
+
+    /* A node pointer under a tag, 16 bits above 48 or 32 above 32 */
+    typedef uint64_t _Word;
+
+    enum { _TAG_SHIFT = sizeof( void * ) == 8 ? 48 : 32 };
+
+    /* ------------------------------ Member types ------------------------------ */
+
+public:
+    typedef T           value_type;
+    typedef Allocator   allocator_type;
+    typedef std::size_t size_type;
+
+    enum { CACHE_LINE = 64, ELIMINATION = 8, PARK_SPINS = 128 };
+
+    /* ------------------------------- Attributes ------------------------------- */
+
+private:
+    struct _Slot {
+        _Word word;
+        char  pad[CACHE_LINE - sizeof( _Word )];
+    };
+
+    allocator_type  _allocator;
+    _Node_allocator _node_allocator;
+    char            _pad0[CACHE_LINE];
+    _Word           _top;
+    char            _pad1[CACHE_LINE];
+    _Word           _free;
+    char            _pad2[CACHE_LINE];
+    _Slot           _slots[ELIMINATION];
+
+    concurrent_stack( const concurrent_stack & );
+    concurrent_stack &operator=( const concurrent_stack & );
+
+    /* ------------------------------ Construction ------------------------------ */
+
+public:
+    explicit concurrent_stack( const allocator_type &alloc = allocator_type() )
+        : _allocator( alloc ),
+          _node_allocator( alloc ),
+          _top( 0 ),
+          _free( 0 ) {
+        for ( int i = 0; i < ELIMINATION; i++ ) { _slots[i].word = 0; }
+    }
+
+    /* No other thread may still be in a call */
+    ~concurrent_stack() {
+        for ( _Node *node = _node( _top ); node; ) {
+            _Node *next = node->next;
+            _allocator.destroy( &node->value );
+            _node_allocator.deallocate( node, 1 );
+            node = next;
+        }
+        for ( _Node *node = _node( _free ); node; ) {
+            _Node *next = node->next;
+            _node_allocator.deallocate( node, 1 );
+            node = next;
+        }
+    }
+
+    /* -------------------------------- Capacity -------------------------------- */
+
+    /* A snapshot, other threads may push or pop right after */
+    bool empty() const {
+        return !_node( __atomic_load_n( &_top, __ATOMIC_ACQUIRE ) );
+    }
+
+    /* -------------------------------- Modifiers ------------------------------- */
+
+    void push( const value_type &val ) {
+        _Node *node = _new_node();
+        try {
+            _allocator.construct( &node->value, val );
+        } catch ( ... ) {
+            _recycle( node );
+            throw;
+        }
+        _push( node );
+    }
+
+#if __cplusplus >= 201103L
+    void push( value_type &&val ) { emplace( std::move( val ) ); }
+
+    template < typename... Args > void emplace( Args &&...args ) {
+        typedef std::allocator_traits< allocator_type > traits;
+        _Node *node = _new_node();
+        try {
+            traits::construct( _allocator,
+                               &node->value,
+                               std::forward< Args >( args )... );
+        } catch ( ... ) {
+            _recycle( node );
+            throw;
+        }
+        _push( node );
+    }
+#endif
+
+    /* Moves the top element to val, false and val untouched when empty */
+    bool pop( value_type &val ) {
+        _Word top = __atomic_load_n( &_top, __ATOMIC_ACQUIRE );
+        for ( ;; ) {
+            _Node *node = _node( top );
+            if ( !node ) { return false; }
+            _Node *next = __atomic_load_n( &node->next, __ATOMIC_RELAXED );
+            if ( __atomic_compare_exchange_n( &_top,
+                                              &top,
+                                              _word( next, top ),
+                                              false,
+                                              __ATOMIC_ACQUIRE,
+                                              __ATOMIC_ACQUIRE ) ) {
+                return _take( node, val );
+            }
+            if ( ( node = _unpark( top ) ) ) {
+                return _take( node, val );
+            }
+            top = __atomic_load_n( &_top, __ATOMIC_ACQUIRE );
+        }
+    }
+
+    /* ---------------------------------- Words --------------------------------- */
+
+private:
+    static _Node *_node( _Word word ) {
+        return reinterpret_cast< _Node * >( static_cast< std::size_t >(
+            word & ( ( _Word( 1 ) << _TAG_SHIFT ) - 1 ) ) );
+    }
+
+    /* node, under the tag after the one of old */
+    static _Word _word( _Node *node, _Word old ) {
+        return _Word( reinterpret_cast< std::size_t >( node ) )
+               | ( ( ( old >> _TAG_SHIFT ) + 1 ) << _TAG_SHIFT );
+    }
+
+    /* ---------------------------------- Nodes --------------------------------- */
+
+    /* From the free list, or the allocator when it is empty */
+    _Node *_new_node() {
+        _Word free = __atomic_load_n( &_free, __ATOMIC_ACQUIRE );
+        for ( ;; ) {
+            _Node *node = _node( free );
+            if ( !node ) { return _node_allocator.allocate( 1 ); }
+            _Node *next = __atomic_load_n( &node->next, __ATOMIC_RELAXED );
+            if ( __atomic_compare_exchange_n( &_free,
+                                              &free,
+                                              _word( next, free ),
+                                              false,
+                                              __ATOMIC_ACQUIRE,
+                                              __ATOMIC_ACQUIRE ) ) {
+                return node;
+            }
+        }
+    }
+
+    void _recycle( _Node *node ) {
+        _Word free = __atomic_load_n( &_free, __ATOMIC_RELAXED );
+        do {
+            __atomic_store_n( &node->next, _node( free ), __ATOMIC_RELAXED );
+        } while ( !__atomic_compare_exchange_n( &_free,
+                                                &free,
+                                                _word( node, free ),
+                                                false,
+                                                __ATOMIC_RELEASE,
+                                                __ATOMIC_RELAXED ) );
+    }
+
+    void _push( _Node *node ) {
+        _Word top = __atomic_load_n( &_top, __ATOMIC_RELAXED );
+        for ( ;; ) {
+            __atomic_store_n( &node->next, _node( top ), __ATOMIC_RELAXED );
+            if ( __atomic_compare_exchange_n( &_top,
+                                              &top,
+                                              _word( node, top ),
+                                              false,
+                                              __ATOMIC_RELEASE,
+                                              __ATOMIC_RELAXED ) ) {
+                return;
+            }
+            if ( _park( node, top ) ) { return; }
+            top = __atomic_load_n( &_top, __ATOMIC_RELAXED );
+        }
+    }
+
+    /* The popped node's element goes to val, the node to the free list */
+    bool _take( _Node *node, value_type &val ) {
+        try {
+            val = ft::_move( node->value );
+        } catch ( ... ) {
+            _push( node );
+            throw;
+        }
+        _allocator.destroy( &node->value );
+        _recycle( node );
+        return true;
+    }
+
+    /* ------------------------------- Elimination ------------------------------ */
+
+    /*
+     * A slot from the top that made the compare-and-swap fail: the push and
+     * the pop that both lost to the same change meet in the same slot.
+     */
+    static std::size_t _pick( _Word seen ) {
+        return std::size_t( ( seen ^ seen >> _TAG_SHIFT ) * 2654435761u >> 7 )
+               % ELIMINATION;
+    }
+
+    /* Offers node to pops for a while, true if one took it */
+    bool _park( _Node *node, _Word seen ) {
+        _Slot &slot  = _slots[_pick( seen )];
+        _Word  empty = __atomic_load_n( &slot.word, __ATOMIC_RELAXED );
+        if ( _node( empty ) ) { return false; }
+        _Word parked = _word( node, empty );
+        if ( !__atomic_compare_exchange_n( &slot.word,
+                                           &empty,
+                                           parked,
+                                           false,
+                                           __ATOMIC_RELEASE,
+                                           __ATOMIC_RELAXED ) ) {
+            return false;
+        }
+        for ( int i = 0; i < PARK_SPINS; i++ ) {
+            if ( __atomic_load_n( &slot.word, __ATOMIC_RELAXED ) != parked ) {
+                return true;
+            }
+        }
+        return !__atomic_compare_exchange_n( &slot.word,
+                                             &parked,
+                                             _word( 0, parked ),
+                                             false,
+                                             __ATOMIC_RELAXED,
+                                             __ATOMIC_RELAXED );
+    }
+
+    /* A node some push parked in the slot, taken out of it, or 0 */
+    _Node *_unpark( _Word seen ) {
+        _Slot &slot   = _slots[_pick( seen )];
+        _Word  parked = __atomic_load_n( &slot.word, __ATOMIC_RELAXED );
+        _Node *node   = _node( parked );
+        if ( node
+             && __atomic_compare_exchange_n( &slot.word,
+                                             &parked,
+                                             _word( 0, parked ),
+                                             false,
+                                             __ATOMIC_ACQUIRE,
+                                             __ATOMIC_RELAXED ) ) {
+            return node;
+        }
+        return 0;
+    }
+
+public:
+    /* -------------------------------- Allocator ------------------------------- */
+
+    allocator_type get_allocator() const { return _allocator; }
+
+    /* -------------------------------------------------------------------------- */
+};
+
+/* -------------------------------------------------------------------------- */
+
+}
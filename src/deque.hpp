@@ -0,0 +1,673 @@
+#pragma once
+
+#include "_uninitialized.hpp"
+#include "algorithm.hpp"
+#include "iterator.hpp"
+#include "type_traits.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+namespace ft {
+
+/* ---------------------------------- Deque --------------------------------- */
+
+/*
+ * Elements live in fixed blocks reached through a map of block pointers,
+ * kept centered so that both ends can grow. Growing allocates a block, now
+ * and then a larger map of pointers, but never moves an element: addresses
+ * stay valid through pushes and pops at either end. Blocks emptied by pops
+ * go back to the allocator right away.
+ */
+template < typename T, typename Allocator = std::allocator< T > >
+class deque {
+
+public:
+    enum { BLOCK_SIZE = sizeof( T ) < 256 ? 4096 / sizeof( T ) : 16 };
+
+private:
+    typedef typename Allocator::pointer                          _Block;
+    typedef typename Allocator::template rebind< _Block >::other _Map_allocator;
+    typedef _Block                                              *_Map_pointer;
+
+    /* -------------------------------- Iterator -------------------------------- */
+
+    /* _cur always points into the block of _node, never at its end */
+    template < typename U > class Iterator {
+    public:
+        typedef U                               value_type;
+        typedef value_type                     &reference;
+        typedef value_type                     *pointer;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef std::random_access_iterator_tag iterator_category;
+
+    private:
+        pointer      _cur;
+        pointer      _first;
+        pointer      _last;
+        _Map_pointer _node;
+
+        friend class deque;
+        template < typename > friend class Iterator;
+
+    public:
+        Iterator() : _cur( 0 ), _first( 0 ), _last( 0 ), _node( 0 ) {}
+        Iterator( pointer cur, _Map_pointer node )
+            : _cur( cur ),
+              _first( node ? *node : 0 ),
+              _last( node ? *node + BLOCK_SIZE : 0 ),
+              _node( node ) {}
+        Iterator( const Iterator &other )
+            : _cur( other._cur ),
+              _first( other._first ),
+              _last( other._last ),
+              _node( other._node ) {}
+
+        Iterator &operator=( const Iterator &other ) {
+            _cur   = other._cur;
+            _first = other._first;
+            _last  = other._last;
+            _node  = other._node;
+            return *this;
+        }
+
+        Iterator operator+( difference_type n ) const {
+            Iterator tmp( *this );
+            return tmp += n;
+        }
+        friend Iterator operator+( difference_type  lhs,
+                                   const Iterator &rhs ) {
+            return rhs + lhs;
+        }
+        Iterator operator-( difference_type n ) const {
+            Iterator tmp( *this );
+            return tmp -= n;
+        }
+        template < typename V >
+        difference_type operator-( const Iterator< V > &other ) const {
+            return difference_type( BLOCK_SIZE )
+                       * ( _node - other._node - ( _node != 0 ) )
+                   + ( _cur - _first ) + ( other._last - other._cur );
+        }
+
+        Iterator &operator++() {
+            if ( ++_cur == _last ) {
+                _set_node( _node + 1 );
+                _cur = _first;
+            }
+            return *this;
+        }
+        Iterator &operator--() {
+            if ( _cur == _first ) {
+                _set_node( _node - 1 );
+                _cur = _last;
+            }
+            _cur--;
+            return *this;
+        }
+        Iterator operator++( int ) {
+            Iterator copy( *this );
+            ++*this;
+            return copy;
+        }
+        Iterator operator--( int ) {
+            Iterator copy( *this );
+            --*this;
+            return copy;
+        }
+
+        Iterator &operator+=( difference_type n ) {
+            difference_type offset = n + ( _cur - _first );
+            difference_type size   = BLOCK_SIZE;
+            if ( offset >= 0 && offset < size ) {
+                _cur += n;
+            } else {
+                difference_type node = offset > 0 ? offset / size
+                                                  : -( ( -offset - 1 ) / size )
+                                                        - 1;
+                _set_node( _node + node );
+                _cur = _first + ( offset - node * size );
+            }
+            return *this;
+        }
+        Iterator &operator-=( difference_type n ) { return *this += -n; }
+
+        template < typename V >
+        bool operator==( const Iterator< V > &other ) const {
+            return ( _cur == other._cur );
+        }
+        template < typename V >
+        bool operator!=( const Iterator< V > &other ) const {
+            return ( _cur != other._cur );
+        }
+        template < typename V >
+        bool operator<( const Iterator< V > &other ) const {
+            return _node == other._node ? _cur < other._cur
+                                        : _node < other._node;
+        }
+        template < typename V >
+        bool operator>( const Iterator< V > &other ) const {
+            return other < *this;
+        }
+        template < typename V >
+        bool operator<=( const Iterator< V > &other ) const {
+            return !( other < *this );
+        }
+        template < typename V >
+        bool operator>=( const Iterator< V > &other ) const {
+            return !( *this < other );
+        }
+
+        reference operator*() const { return *_cur; }
+        reference operator[]( difference_type i ) const {
+            return *( *this + i );
+        }
+        pointer operator->() const { return ( _cur ); };
+
+        operator Iterator< const U >() const {
+            return ( Iterator< const U >( _cur, _node ) );
+        }
+
+    private:
+        void _set_node( _Map_pointer node ) {
+            _node  = node;
+            _first = *node;
+            _last  = _first + BLOCK_SIZE;
+        }
+    };
+
+    /* ------------------------------ Member types ------------------------------ */
+
+public:
+    typedef T                                        value_type;
+    typedef Allocator                                allocator_type;
+    typedef typename allocator_type::reference       reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer         pointer;
+    typedef typename allocator_type::const_pointer   const_pointer;
+    typedef Iterator< value_type >                  iterator;
+    typedef Iterator< const value_type >            const_iterator;
+    typedef ft::reverse_iterator< iterator >         reverse_iterator;
+    typedef ft::reverse_iterator< const_iterator >   const_reverse_iterator;
+    typedef std::ptrdiff_t                           difference_type;
+    typedef std::size_t                              size_type;
+
+    /* ------------------------------- Attributes ------------------------------- */
+
+protected:
+    allocator_type _allocator;
+    _Map_allocator _map_allocator;
+    _Map_pointer   _map;
+    size_type      _map_size;
+    iterator       _start;
+    iterator       _finish;
+
+    /* ------------------------------ Construction ------------------------------ */
+
+public:
+    explicit deque( const allocator_type &alloc = allocator_type() )
+        : _allocator( alloc ),
+          _map_allocator( alloc ),
+          _map( 0 ),
+          _map_size( 0 ) {
+        _initialize();
+    }
+
+    explicit deque( size_type             n,
+                    const value_type     &val   = value_type(),
+                    const allocator_type &alloc = allocator_type() )
+        : _allocator( alloc ),
+          _map_allocator( alloc ),
+          _map( 0 ),
+          _map_size( 0 ) {
+        _initialize();
+        try {
+            assign( n, val );
+        } catch ( ... ) {
+            _release();
+            throw;
+        }
+    }
+
+    template < class U >
+    deque(
+        U                     first,
+        U                     last,
+        const allocator_type &alloc = allocator_type(),
+        typename ft::enable_if< !ft::is_integral< U >::value, U >::type * = 0 )
+        : _allocator( alloc ),
+          _map_allocator( alloc ),
+          _map( 0 ),
+          _map_size( 0 ) {
+        _initialize();
+        try {
+            assign( first, last );
+        } catch ( ... ) {
+            _release();
+            throw;
+        }
+    }
+
+    deque( const deque &other )
+        : _allocator( other._allocator ),
+          _map_allocator( other._map_allocator ),
+          _map( 0 ),
+          _map_size( 0 ) {
+        _initialize();
+        try {
+            assign( other.begin(), other.end() );
+        } catch ( ... ) {
+            _release();
+            throw;
+        }
+    }
+
+    virtual ~deque() { _release(); }
+
+    deque &operator=( const deque &other ) {
+        if ( this != &other ) { assign( other.begin(), other.end() ); }
+        return *this;
+    }
+
+#if __cplusplus >= 201103L
+    /* The blocks change hands, other is left with a fresh empty map */
+    deque( deque &&other )
+        : _allocator( std::move( other._allocator ) ),
+          _map_allocator( other._map_allocator ),
+          _map( 0 ),
+          _map_size( 0 ) {
+        _initialize();
+        swap( other );
+    }
+
+    /* Our old elements go with other */
+    deque &operator=( deque &&other ) noexcept {
+        swap( other );
+        return *this;
+    }
+#endif
+
+    /* -------------------------------- Capacity -------------------------------- */
+
+    size_type size() const { return _finish - _start; }
+
+    size_type max_size() const { return _allocator.max_size(); }
+
+    void resize( size_type n, value_type val = value_type() ) {
+        size_type len = size();
+        if ( n > len ) {
+            insert( end(), n - len, val );
+        } else {
+            erase( begin() + n, end() );
+        }
+    }
+
+    bool empty() const { return _start == _finish; }
+
+    /* -------------------------------- Iterators ------------------------------- */
+
+    iterator               begin() { return _start; }
+    const_iterator         begin() const { return _start; }
+    iterator               end() { return _finish; }
+    const_iterator         end() const { return _finish; }
+    reverse_iterator       rbegin() { return reverse_iterator( end() ); }
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator( end() );
+    }
+    reverse_iterator       rend() { return reverse_iterator( begin() ); }
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator( begin() );
+    }
+
+    /* ----------------------------- Element access ----------------------------- */
+
+    reference       operator[]( size_type i ) { return _start[i]; }
+    const_reference operator[]( size_type i ) const { return begin()[i]; }
+
+    reference at( size_type i ) {
+        if ( i >= size() ) { throw std::out_of_range( "deque::at" ); }
+        return operator[]( i );
+    }
+    const_reference at( size_type i ) const {
+        if ( i >= size() ) { throw std::out_of_range( "deque::at" ); }
+        return operator[]( i );
+    }
+
+    reference       front() { return *_start; }
+    const_reference front() const { return *_start; }
+    reference       back() { return *( _finish - 1 ); }
+    const_reference back() const { return *( _finish - 1 ); }
+
+    /* -------------------------------- Modifiers ------------------------------- */
+
+    template < class U >
+    void assign( U first,
+                 U last,
+                 typename ft::enable_if< !ft::is_integral< U >::value, U >::type
+                     * = 0 ) {
+        clear();
+        insert( end(), first, last );
+    }
+
+    void assign( size_type n, const value_type &val ) {
+        clear();
+        insert( end(), n, val );
+    }
+
+    void push_back( const value_type &val ) {
+        if ( _finish._cur != _finish._last - 1 ) {
+            _allocator.construct( _finish._cur, val );
+            _finish._cur++;
+            return;
+        }
+        _add_block_back();
+        try {
+            _allocator.construct( _finish._cur, val );
+        } catch ( ... ) {
+            _allocator.deallocate( _finish._node[1], BLOCK_SIZE );
+            throw;
+        }
+        _finish._set_node( _finish._node + 1 );
+        _finish._cur = _finish._first;
+    }
+
+    void push_front( const value_type &val ) {
+        if ( _start._cur != _start._first ) {
+            _allocator.construct( _start._cur - 1, val );
+            _start._cur--;
+            return;
+        }
+        _add_block_front();
+        try {
+            _allocator.construct( _start._node[-1] + BLOCK_SIZE - 1, val );
+        } catch ( ... ) {
+            _allocator.deallocate( _start._node[-1], BLOCK_SIZE );
+            throw;
+        }
+        _start._set_node( _start._node - 1 );
+        _start._cur = _start._last - 1;
+    }
+
+#if __cplusplus >= 201103L
+    void push_back( value_type &&val ) { emplace_back( std::move( val ) ); }
+    void push_front( value_type &&val ) { emplace_front( std::move( val ) ); }
+
+    template < typename... Args > void emplace_back( Args &&...args ) {
+        typedef std::allocator_traits< allocator_type > traits;
+        if ( _finish._cur != _finish._last - 1 ) {
+            traits::construct( _allocator,
+                               _finish._cur,
+                               std::forward< Args >( args )... );
+            _finish._cur++;
+            return;
+        }
+        _add_block_back();
+        try {
+            traits::construct( _allocator,
+                               _finish._cur,
+                               std::forward< Args >( args )... );
+        } catch ( ... ) {
+            _allocator.deallocate( _finish._node[1], BLOCK_SIZE );
+            throw;
+        }
+        _finish._set_node( _finish._node + 1 );
+        _finish._cur = _finish._first;
+    }
+
+    template < typename... Args > void emplace_front( Args &&...args ) {
+        typedef std::allocator_traits< allocator_type > traits;
+        if ( _start._cur != _start._first ) {
+            traits::construct( _allocator,
+                               _start._cur - 1,
+                               std::forward< Args >( args )... );
+            _start._cur--;
+            return;
+        }
+        _add_block_front();
+        try {
+            traits::construct( _allocator,
+                               _start._node[-1] + BLOCK_SIZE - 1,
+                               std::forward< Args >( args )... );
+        } catch ( ... ) {
+            _allocator.deallocate( _start._node[-1], BLOCK_SIZE );
+            throw;
+        }
+        _start._set_node( _start._node - 1 );
+        _start._cur = _start._last - 1;
+    }
+#endif
+
+    void pop_back() {
+        if ( empty() ) { return; }
+        if ( _finish._cur == _finish._first ) {
+            _allocator.deallocate( _finish._first, BLOCK_SIZE );
+            _finish._set_node( _finish._node - 1 );
+            _finish._cur = _finish._last;
+        }
+        _finish._cur--;
+        _allocator.destroy( _finish._cur );
+    }
+
+    void pop_front() {
+        if ( empty() ) { return; }
+        _allocator.destroy( _start._cur );
+        if ( _start._cur != _start._last - 1 ) {
+            _start._cur++;
+            return;
+        }
+        _allocator.deallocate( _start._first, BLOCK_SIZE );
+        _start._set_node( _start._node + 1 );
+        _start._cur = _start._first;
+    }
+
+    iterator insert( iterator position, const value_type &val ) {
+        difference_type i = position - begin();
+        insert( position, 1, val );
+        return begin() + i;
+    }
+
+    /* Pushes at whichever end is closer, then rotates into place */
+    void insert( iterator position, size_type n, const value_type &val ) {
+        size_type i     = position - begin();
+        size_type len   = size();
+        bool      front = i < len / 2;
+        try {
+            for ( size_type k = 0; k < n; k++ ) {
+                front ? push_front( val ) : push_back( val );
+            }
+        } catch ( ... ) {
+            _shrink( len, front );
+            throw;
+        }
+        if ( front ) {
+            std::rotate( begin(), begin() + n, begin() + n + i );
+        } else {
+            std::rotate( begin() + i, begin() + len, end() );
+        }
+    }
+
+    /* Single pass, pushed in reverse at the front and then flipped */
+    template < typename U >
+    void insert( iterator position,
+                 U        first,
+                 U        last,
+                 typename ft::enable_if< !ft::is_integral< U >::value, U >::type
+                     * = 0 ) {
+        size_type i     = position - begin();
+        size_type len   = size();
+        bool      front = i < len / 2;
+        try {
+            for ( ; first != last; ++first ) {
+                front ? push_front( *first ) : push_back( *first );
+            }
+        } catch ( ... ) {
+            _shrink( len, front );
+            throw;
+        }
+        size_type n = size() - len;
+        if ( front ) {
+            std::reverse( begin(), begin() + n );
+            std::rotate( begin(), begin() + n, begin() + n + i );
+        } else {
+            std::rotate( begin() + i, begin() + len, end() );
+        }
+    }
+
+    iterator erase( iterator i ) { return erase( i, i + 1 ); }
+
+    /* Closes the gap from whichever side has fewer elements to shift */
+    iterator erase( iterator first, iterator last ) {
+        difference_type n      = last - first;
+        difference_type before = first - begin();
+        if ( before < difference_type( size() - n ) / 2 ) {
+            std::copy_backward( begin(), first, last );
+            for ( ; n; n-- ) { pop_front(); }
+        } else {
+            std::copy( last, end(), first );
+            for ( ; n; n-- ) { pop_back(); }
+        }
+        return begin() + before;
+    }
+
+    /* Erases the elements pred holds for, survivors slide down in one pass */
+    template < typename Predicate > size_type erase_if( Predicate pred ) {
+        iterator  it = std::remove_if( begin(), end(), pred );
+        size_type n  = end() - it;
+        erase( it, end() );
+        return n;
+    }
+
+    void swap( deque &other ) {
+        ft::swap( _map, other._map );
+        ft::swap( _map_size, other._map_size );
+        ft::swap( _start, other._start );
+        ft::swap( _finish, other._finish );
+    }
+
+    /* Keeps the first block and the map, every other block is released */
+    void clear() {
+        ft::_destroy( begin(), end(), _allocator );
+        for ( _Map_pointer node = _start._node + 1; node <= _finish._node;
+              node++ ) {
+            _allocator.deallocate( *node, BLOCK_SIZE );
+        }
+        _finish = _start;
+    }
+
+    /* ----------------------------------- Map ---------------------------------- */
+
+private:
+    /* An empty map of a few slots, one block in the middle */
+    void _initialize() {
+        _map_size = 8;
+        _map      = _map_allocator.allocate( _map_size );
+        try {
+            _map[_map_size / 2] = _allocator.allocate( BLOCK_SIZE );
+        } catch ( ... ) {
+            _map_allocator.deallocate( _map, _map_size );
+            throw;
+        }
+        _start  = iterator( _map[_map_size / 2], _map + _map_size / 2 );
+        _finish = _start;
+    }
+
+    void _release() {
+        clear();
+        _allocator.deallocate( *_start._node, BLOCK_SIZE );
+        _map_allocator.deallocate( _map, _map_size );
+    }
+
+    /* Pops what a failed insert pushed at one end */
+    void _shrink( size_type len, bool front ) {
+        while ( size() > len ) { front ? pop_front() : pop_back(); }
+    }
+
+    /* Allocates the block after the last one, the map grows first if full */
+    void _add_block_back() {
+        if ( _finish._node == _map + _map_size - 1 ) {
+            _reallocate_map( 1, false );
+        }
+        _finish._node[1] = _allocator.allocate( BLOCK_SIZE );
+    }
+
+    void _add_block_front() {
+        if ( _start._node == _map ) { _reallocate_map( 1, true ); }
+        _start._node[-1] = _allocator.allocate( BLOCK_SIZE );
+    }
+
+    /*
+     * Leaves room for n more blocks at one end. A mostly empty map is just
+     * recentered, otherwise the pointers move to one twice as large: the
+     * blocks themselves, and so the elements, stay where they are.
+     */
+    void _reallocate_map( size_type n, bool front ) {
+        size_type    used  = _finish._node - _start._node + 1;
+        size_type    nodes = used + n;
+        _Map_pointer node;
+        if ( _map_size > 2 * nodes ) {
+            node = _map + ( _map_size - nodes ) / 2 + ( front ? n : 0 );
+            if ( node < _start._node ) {
+                std::copy( _start._node, _finish._node + 1, node );
+            } else {
+                std::copy_backward( _start._node,
+                                    _finish._node + 1,
+                                    node + used );
+            }
+        } else {
+            size_type    size = _map_size + std::max( _map_size, n ) + 2;
+            _Map_pointer map  = _map_allocator.allocate( size );
+            node = map + ( size - nodes ) / 2 + ( front ? n : 0 );
+            std::copy( _start._node, _finish._node + 1, node );
+            _map_allocator.deallocate( _map, _map_size );
+            _map      = map;
+            _map_size = size;
+        }
+        _start._set_node( node );
+        _finish._set_node( node + used - 1 );
+    }
+
+public:
+    /* -------------------------------- Allocator ------------------------------- */
+
+    allocator_type get_allocator() const { return _allocator; }
+
+    /* -------------------------- Relational operators -------------------------- */
+
+    bool operator==( const deque &other ) const {
+        return size() == other.size()
+               && ft::equal( begin(), end(), other.begin() );
+    }
+    bool operator!=( const deque &other ) const { return !( *this == other ); }
+    bool operator<( const deque &other ) const {
+        return ft::lexicographical_compare( begin(),
+                                            end(),
+                                            other.begin(),
+                                            other.end() );
+    }
+    bool operator<=( const deque &other ) const {
+        return *this == other || *this < other;
+    }
+    bool operator>( const deque &other ) const { return !( *this <= other ); }
+    bool operator>=( const deque &other ) const { return !( *this < other ); }
+
+    /* -------------------------------------------------------------------------- */
+};
+
+/* ---------------------------------- Swap ---------------------------------- */
+
+template < typename T, typename A >
+void swap( deque< T, A > &x, deque< T, A > &y ) {
+    x.swap( y );
+}
+
+/* -------------------------------- Erase if -------------------------------- */
+
+template < typename T, typename A, typename Predicate >
+typename deque< T, A >::size_type erase_if( deque< T, A > &c, Predicate pred ) {
+    return c.erase_if( pred );
+}
+
+/* -------------------------------------------------------------------------- */
+
+}
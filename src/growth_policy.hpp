@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+
+#if defined( __GLIBC__ )
+#include <malloc.h>
+#elif defined( __APPLE__ )
+#include <malloc/malloc.h>
+#endif
+
+namespace ft {
+
+/*
+ * How vector picks a new capacity. next( size, required ) is the capacity
+ * to grow to once size elements no longer leave room for required ones,
+ * and usable( p, n, element_size ) how many elements the block the
+ * allocator returned for n of them can actually hold.
+ */
+
+/* -------------------------------- Exact fit ------------------------------- */
+
+struct _Growth_exact_fit {
+    static std::size_t usable( const void *, std::size_t n, std::size_t ) {
+        return n;
+    }
+};
+
+/* --------------------------------- Double --------------------------------- */
+
+/* What std::vector does, at most half the capacity is left unused */
+struct growth_double : public _Growth_exact_fit {
+    static std::size_t next( std::size_t size, std::size_t required ) {
+        return size + std::max( size, required - size );
+    }
+};
+
+/* ------------------------------ One and half ------------------------------ */
+
+/* Lets a freed run of earlier blocks fit a later request */
+struct growth_one_and_half : public _Growth_exact_fit {
+    static std::size_t next( std::size_t size, std::size_t required ) {
+        return std::max( size + ( size >> 1 ), required );
+    }
+};
+
+/* ---------------------------------- Chunk --------------------------------- */
+
+/* Capacity in multiples of Chunk elements, waste bounded by one chunk */
+template < std::size_t Chunk > struct growth_chunk : public _Growth_exact_fit {
+    static std::size_t next( std::size_t, std::size_t required ) {
+        return ( required + Chunk - 1 ) / Chunk * Chunk;
+    }
+};
+
+/* ------------------------------- Size class ------------------------------- */
+
+/*
+ * Grows as Policy does, then claims the slack malloc rounded the block up
+ * to. Only for allocators handing out malloc blocks, std::allocator with
+ * the default operator new among them.
+ */
+template < typename Policy = growth_double > struct growth_size_class {
+    static std::size_t next( std::size_t size, std::size_t required ) {
+        return Policy::next( size, required );
+    }
+    static std::size_t
+    usable( const void *p, std::size_t n, std::size_t element_size ) {
+        if ( !p ) { return n; }
+#if defined( __GLIBC__ )
+        return malloc_usable_size( const_cast< void * >( p ) ) / element_size;
+#elif defined( __APPLE__ )
+        return malloc_size( p ) / element_size;
+#else
+        return n;
+#endif
+    }
+};
+
+/* -------------------------------------------------------------------------- */
+
+}
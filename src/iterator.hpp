@@ -1,5 +1,6 @@
 #pragma once
 
+#include "type_traits.hpp"
 #include <iterator>
 
 namespace ft {
@@ -113,6 +114,34 @@ public:
     pointer   operator->() const { return ( --T( _it ) ).operator->(); };
 };
 
+/* ------------------------------- Contiguous ------------------------------- */
+
+/* Random access iterators over elements laid out as in an array */
+struct contiguous_iterator_tag : public std::random_access_iterator_tag {};
+
+template < typename I, typename = void > struct _Iterator_concept {
+    typedef typename I::iterator_category type;
+};
+
+template < typename I >
+struct _Iterator_concept< I,
+                          typename enable_if< sizeof( typename I::
+                                                          iterator_concept )
+                                              != 0 >::type > {
+    typedef typename I::iterator_concept type;
+};
+
+/* Pointers, and iterators with contiguous_iterator_tag as iterator_concept */
+template < typename I >
+struct is_contiguous_iterator
+    : public integral_constant<
+          bool,
+          is_same< typename _Iterator_concept< I >::type,
+                   contiguous_iterator_tag >::value > {};
+
+template < typename T >
+struct is_contiguous_iterator< T * > : public true_type {};
+
 /* -------------------------------------------------------------------------- */
 
 }
\ No newline at end of file
@@ -7,8 +7,9 @@
 namespace ft {
 template < typename K,
            typename V,
-           typename Comp      = std::less< K >,
-           typename Allocator = std::allocator< ft::pair< const K, V > > >
+           typename Comp = std::less< K >,
+           typename Allocator
+           = FT_TREE_ALLOCATOR< ft::pair< const K, V > > >
 class map {
 
     /* ------------------------------ Member types ------------------------------ */
@@ -141,7 +142,7 @@ public:
     /* ----------------------------- Element access ----------------------------- */
 
     mapped_type &operator[]( const key_type &k ) {
-        return _tree.insert( value_type( k, mapped_type() ) ).first->second;
+        return _tree.try_emplace( k ).first->second;
     }
     mapped_type &at( const key_type &k ) {
         iterator it = _tree.find( k );
@@ -167,9 +168,25 @@ public:
         _tree.insert( first, last );
     }
 
+    ft::pair< iterator, bool > try_emplace( const key_type &k ) {
+        return _tree.try_emplace( k );
+    }
+    template < typename M >
+    ft::pair< iterator, bool > try_emplace( const key_type &k, const M &obj ) {
+        return _tree.try_emplace( k, obj );
+    }
+    template < typename M >
+    ft::pair< iterator, bool > insert_or_assign( const key_type &k,
+                                                 const M        &obj ) {
+        return _tree.insert_or_assign( k, obj );
+    }
+
     void      erase( iterator position ) { _tree.erase( position->first ); }
     size_type erase( const key_type &k ) { return _tree.erase( k ); }
     void erase( iterator first, iterator last ) { _tree.erase( first, last ); }
+    template < typename Predicate > size_type erase_if( Predicate pred ) {
+        return _tree.erase_if( pred );
+    }
 
     void swap( map &other ) { ft::swap( _tree, other._tree ); }
 
@@ -197,12 +214,10 @@ public:
     }
     ft::pair< const_iterator, const_iterator >
     equal_range( const key_type &k ) const {
-        return ft::pair< const_iterator, const_iterator >( lower_bound( k ),
-                                                           upper_bound( k ) );
+        return _tree.equal_range( k );
     }
     ft::pair< iterator, iterator > equal_range( const key_type &k ) {
-        return ft::pair< iterator, iterator >( lower_bound( k ),
-                                               upper_bound( k ) );
+        return _tree.equal_range( k );
     }
 
     /* -------------------------------- Allocator ------------------------------- */
@@ -229,6 +244,14 @@ void swap( map< Key, T, Compare, Alloc > &lhs,
     lhs.swap( rhs );
 }
 
+/* -------------------------------- Erase if -------------------------------- */
+
+template < class Key, class T, class Compare, class Alloc, class Predicate >
+typename map< Key, T, Compare, Alloc >::size_type
+erase_if( map< Key, T, Compare, Alloc > &c, Predicate pred ) {
+    return c.erase_if( pred );
+}
+
 /* -------------------------------------------------------------------------- */
 
 }
\ No newline at end of file
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "type_traits.hpp"
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ft {
+
+/* ---------------------------------- Flags --------------------------------- */
+
+enum {
+    MMAP_POPULATE   = 1 << 0, /* Fault the pages in up front */
+    MMAP_HUGE_PAGES = 1 << 1, /* Ask for transparent huge pages */
+};
+
+/* -------------------------------- Allocator ------------------------------- */
+
+/*
+ * Buffers of Threshold bytes or more are anonymous mappings, which remap()
+ * grows with mremap: the kernel moves page tables instead of bytes. Smaller
+ * ones come from operator new. As remap() moves elements as raw bytes,
+ * vector only uses it for trivially relocatable types. Outside Linux every
+ * buffer comes from operator new.
+ */
+template < typename T, int Flags = 0, std::size_t Threshold = 1 << 20 >
+class mmap_allocator {
+public:
+    typedef T                 value_type;
+    typedef value_type       *pointer;
+    typedef const value_type *const_pointer;
+    typedef value_type       &reference;
+    typedef const value_type &const_reference;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+
+    template < typename U > struct rebind {
+        typedef mmap_allocator< U, Flags, Threshold > other;
+    };
+
+    mmap_allocator() throw() {}
+    template < typename U >
+    mmap_allocator( const mmap_allocator< U, Flags, Threshold > & ) throw() {}
+
+    pointer allocate( size_type n, const void * = 0 ) {
+        if ( n > max_size() ) { throw std::bad_alloc(); }
+        if ( !_mapped( n ) ) {
+            return static_cast< pointer >( ::operator new( n * sizeof( T ) ) );
+        }
+        return static_cast< pointer >( _map( _length( n ) ) );
+    }
+
+    void deallocate( pointer p, size_type n ) {
+        if ( !_mapped( n ) ) {
+            ::operator delete( p );
+            return;
+        }
+#ifdef __linux__
+        munmap( p, _length( n ) );
+#endif
+    }
+
+    /*
+     * The old_n elements of p moved to a buffer of n as raw bytes, by mremap.
+     * 0 when either buffer is too small to be a mapping: then the caller
+     * moves the elements itself.
+     */
+    pointer remap( pointer p, size_type old_n, size_type n ) {
+        if ( n > max_size() ) { throw std::bad_alloc(); }
+        if ( !_mapped( old_n ) || !_mapped( n ) ) { return 0; }
+#ifdef __linux__
+        void *q = mremap( p, _length( old_n ), _length( n ), MREMAP_MAYMOVE );
+        if ( q == MAP_FAILED ) { throw std::bad_alloc(); }
+        _advise( q, _length( n ) );
+        return static_cast< pointer >( q );
+#else
+        return ( void )p, pointer( 0 );
+#endif
+    }
+
+    void construct( pointer p, const_reference val ) {
+        ::new ( static_cast< void * >( p ) ) value_type( val );
+    }
+    void destroy( pointer p ) { p->~value_type(); }
+
+    size_type max_size() const throw() {
+        return std::numeric_limits< size_type >::max() / sizeof( T );
+    }
+    pointer       address( reference x ) const { return &x; }
+    const_pointer address( const_reference x ) const { return &x; }
+
+private:
+    static bool _mapped( size_type n ) {
+#ifdef __linux__
+        return n * sizeof( T ) >= Threshold;
+#else
+        return ( void )n, false;
+#endif
+    }
+
+#ifdef __linux__
+    static std::size_t _length( size_type n ) {
+        static const std::size_t page = sysconf( _SC_PAGESIZE );
+        return ( n * sizeof( T ) + page - 1 ) / page * page;
+    }
+
+    static void *_map( std::size_t length ) {
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        if ( Flags & MMAP_POPULATE ) { flags |= MAP_POPULATE; }
+        void *p = mmap( 0, length, PROT_READ | PROT_WRITE, flags, -1, 0 );
+        if ( p == MAP_FAILED ) { throw std::bad_alloc(); }
+        _advise( p, length );
+        return p;
+    }
+
+    static void _advise( void *p, std::size_t length ) {
+#ifdef MADV_HUGEPAGE
+        if ( Flags & MMAP_HUGE_PAGES ) { madvise( p, length, MADV_HUGEPAGE ); }
+#endif
+#ifdef MADV_POPULATE_WRITE
+        if ( Flags & MMAP_POPULATE ) {
+            madvise( p, length, MADV_POPULATE_WRITE );
+        }
+#endif
+        ( void )p, ( void )length;
+    }
+#else
+    static std::size_t _length( size_type n ) { return n * sizeof( T ); }
+    static void       *_map( std::size_t length ) {
+        return ::operator new( length );
+    }
+#endif
+};
+
+template < typename T, typename U, int F, std::size_t N >
+bool operator==( const mmap_allocator< T, F, N > &,
+                 const mmap_allocator< U, F, N > & ) {
+    return true;
+}
+template < typename T, typename U, int F, std::size_t N >
+bool operator!=( const mmap_allocator< T, F, N > &,
+                 const mmap_allocator< U, F, N > & ) {
+    return false;
+}
+
+/* ---------------------------------- Remap --------------------------------- */
+
+/* Allocators with a remap( p, old_n, n ) moving buffers as raw bytes */
+template < typename Alloc > struct allocator_remaps : public false_type {};
+
+template < typename T, int F, std::size_t N >
+struct allocator_remaps< mmap_allocator< T, F, N > > : public true_type {};
+
+/* -------------------------------------------------------------------------- */
+
+}
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "algorithm.hpp"
+#include "pool_allocator.hpp"
+#include "vector.hpp"
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace ft {
+
+/* ------------------------------ Pairing heap ------------------------------ */
+
+/*
+ * An addressable max-heap: push returns a handle to the element that stays
+ * valid until the element leaves, through pop or erase. Nodes come one at a
+ * time from Allocator, a pool by default, and never move.
+ *
+ * decrease_key takes the element closer to the top, which for a min-heap
+ * (Compare = std::greater) means a smaller key: Dijkstra's update. Pushes,
+ * merges and decrease_key are O(1), pop and erase O(log n) amortized.
+ */
+template < typename T,
+           typename Compare   = std::less< T >,
+           typename Allocator = ft::pool_allocator< T > >
+class pairing_heap {
+
+    /* ---------------------------------- Node ---------------------------------- */
+
+    /* First child, next sibling, and the previous sibling or the parent */
+    struct _Node {
+        T      value;
+        _Node *child;
+        _Node *next;
+        _Node *prev;
+    };
+
+    typedef typename Allocator::template rebind< _Node >::other
+        _Node_allocator;
+
+    /* ------------------------------ Member types ------------------------------ */
+
+public:
+    typedef T                                        value_type;
+    typedef Compare                                  value_compare;
+    typedef Allocator                                allocator_type;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::const_pointer   const_pointer;
+    typedef std::size_t                              size_type;
+
+    /* --------------------------------- Handle --------------------------------- */
+
+    class handle {
+        _Node *_node;
+
+        friend class pairing_heap;
+
+        handle( _Node *node ) : _node( node ) {}
+
+    public:
+        handle() : _node( 0 ) {}
+
+        const_reference operator*() const { return _node->value; }
+        const_pointer   operator->() const { return &_node->value; }
+
+        bool operator==( const handle &other ) const {
+            return _node == other._node;
+        }
+        bool operator!=( const handle &other ) const {
+            return _node != other._node;
+        }
+    };
+
+    typedef handle handle_type;
+
+    /* ------------------------------- Attributes ------------------------------- */
+
+protected:
+    allocator_type  _allocator;
+    _Node_allocator _node_allocator;
+    value_compare   _comp;
+    _Node          *_root;
+    size_type       _size;
+
+    /* ------------------------------ Construction ------------------------------ */
+
+public:
+    explicit pairing_heap( const value_compare  &comp  = value_compare(),
+                           const allocator_type &alloc = allocator_type() )
+        : _allocator( alloc ),
+          _node_allocator( alloc ),
+          _comp( comp ),
+          _root( 0 ),
+          _size( 0 ) {}
+
+    /* Walks the tree with a stack of its own, paths can be n nodes deep */
+    pairing_heap( const pairing_heap &other )
+        : _allocator( other._allocator ),
+          _node_allocator( other._node_allocator ),
+          _comp( other._comp ),
+          _root( 0 ),
+          _size( 0 ) {
+        ft::vector< const _Node * > stack;
+        try {
+            if ( other._root ) { stack.push_back( other._root ); }
+            while ( !stack.empty() ) {
+                const _Node *node = stack.back();
+                stack.pop_back();
+                push( node->value );
+                if ( node->next ) { stack.push_back( node->next ); }
+                if ( node->child ) { stack.push_back( node->child ); }
+            }
+        } catch ( ... ) {
+            clear();
+            throw;
+        }
+    }
+
+    ~pairing_heap() { clear(); }
+
+    pairing_heap &operator=( const pairing_heap &other ) {
+        pairing_heap tmp( other );
+        swap( tmp );
+        return *this;
+    }
+
+    /* -------------------------------- Capacity -------------------------------- */
+
+    bool      empty() const { return !_root; }
+    size_type size() const { return _size; }
+
+    /* ----------------------------- Element access ----------------------------- */
+
+    const_reference top() const { return _root->value; }
+
+    handle top_handle() const { return _root; }
+
+    /* -------------------------------- Modifiers ------------------------------- */
+
+    handle push( const value_type &val ) {
+        _Node *node = _node_allocator.allocate( 1 );
+        try {
+            _allocator.construct( &node->value, val );
+        } catch ( ... ) {
+            _node_allocator.deallocate( node, 1 );
+            throw;
+        }
+        node->child = 0;
+        node->next  = 0;
+        node->prev  = 0;
+        _root       = _meld( _root, node );
+        _size++;
+        return node;
+    }
+
+    /* The root's children pair up into the new root */
+    void pop() {
+        if ( !_root ) { return; }
+        _Node *root = _root;
+        _root       = _combine( root->child );
+        _destroy( root );
+    }
+
+    /* val must not rank below the element's value: it only rises */
+    void decrease_key( handle h, const value_type &val ) {
+        _Node *node = h._node;
+        node->value = val;
+        if ( node != _root ) {
+            _cut( node );
+            _root = _meld( _root, node );
+        }
+    }
+
+    /* Any new value, a rise as decrease_key, a fall by pairing anew */
+    void update( handle h, const value_type &val ) {
+        _Node *node = h._node;
+        if ( !_comp( val, node->value ) ) {
+            decrease_key( h, val );
+            return;
+        }
+        node->value = val;
+        _detach( node );
+        _root = _meld( _root, node );
+    }
+
+    void erase( handle h ) {
+        _detach( h._node );
+        _destroy( h._node );
+    }
+
+    /* Takes every element of other, whose handles now refer to ours */
+    void merge( pairing_heap &other ) {
+        if ( this == &other ) { return; }
+        _root        = _meld( _root, other._root );
+        _size       += other._size;
+        other._root  = 0;
+        other._size  = 0;
+    }
+
+    void swap( pairing_heap &other ) {
+        ft::swap( _comp, other._comp );
+        ft::swap( _root, other._root );
+        ft::swap( _size, other._size );
+    }
+
+    /*
+     * Unrolls the tree as it goes: a node with a child is rotated under it,
+     * one without is freed. No stack, however deep the tree.
+     */
+    void clear() {
+        _Node *node = _root;
+        while ( node ) {
+            if ( _Node *child = node->child ) {
+                node->child = child->next;
+                child->next = node;
+                node        = child;
+            } else {
+                _Node *next = node->next;
+                _allocator.destroy( &node->value );
+                _node_allocator.deallocate( node, 1 );
+                node = next;
+            }
+        }
+        _root = 0;
+        _size = 0;
+    }
+
+    /* --------------------------------- Pairing -------------------------------- */
+
+private:
+    /* Two roots become one, the loser first child of the winner */
+    _Node *_meld( _Node *a, _Node *b ) {
+        if ( !a ) { return b; }
+        if ( !b ) { return a; }
+        if ( _comp( a->value, b->value ) ) { ft::swap( a, b ); }
+        b->next = a->child;
+        if ( a->child ) { a->child->prev = b; }
+        b->prev  = a;
+        a->child = b;
+        return a;
+    }
+
+    /*
+     * Siblings melded two by two from the left, then the pairs into one
+     * from the right: the pass that gives pairing heaps their bounds.
+     */
+    _Node *_combine( _Node *first ) {
+        _Node *pairs = 0;
+        while ( first ) {
+            _Node *a = first;
+            _Node *b = a->next;
+            first    = b ? b->next : 0;
+            a->next  = 0;
+            a->prev  = 0;
+            if ( b ) {
+                b->next = 0;
+                b->prev = 0;
+                a       = _meld( a, b );
+            }
+            a->next = pairs;
+            pairs   = a;
+        }
+        _Node *root = pairs;
+        if ( root ) {
+            pairs      = root->next;
+            root->next = 0;
+        }
+        while ( pairs ) {
+            _Node *node = pairs;
+            pairs       = node->next;
+            node->next  = 0;
+            root        = _meld( root, node );
+        }
+        return root;
+    }
+
+    /* Unlinks a node other than the root, with its subtree */
+    void _cut( _Node *node ) {
+        if ( node->prev->child == node ) {
+            node->prev->child = node->next;
+        } else {
+            node->prev->next = node->next;
+        }
+        if ( node->next ) { node->next->prev = node->prev; }
+        node->next = 0;
+        node->prev = 0;
+    }
+
+    /* Takes node out alone, its children pair up and go back in */
+    void _detach( _Node *node ) {
+        _Node *children = node->child;
+        node->child     = 0;
+        if ( node == _root ) {
+            _root = 0;
+        } else {
+            _cut( node );
+        }
+        _root = _meld( _root, _combine( children ) );
+    }
+
+    void _destroy( _Node *node ) {
+        _allocator.destroy( &node->value );
+        _node_allocator.deallocate( node, 1 );
+        _size--;
+    }
+
+public:
+    /* -------------------------------- Allocator ------------------------------- */
+
+    allocator_type get_allocator() const { return _allocator; }
+
+    /* -------------------------------------------------------------------------- */
+};
+
+/* ---------------------------------- Swap ---------------------------------- */
+
+template < typename T, typename C, typename A >
+void swap( pairing_heap< T, C, A > &x, pairing_heap< T, C, A > &y ) {
+    x.swap( y );
+}
+
+/* -------------------------------------------------------------------------- */
+
+}
@@ -0,0 +1,776 @@
+#pragma once
+
+#include "_uninitialized.hpp"
+#include "iterator.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <pthread.h>
+#include <stdexcept>
+#include <unistd.h>
+
+#if __cplusplus >= 201103L
+#include <exception>
+#endif
+
+namespace ft {
+namespace parallel {
+
+/* ---------------------------------- Error --------------------------------- */
+
+/*
+ * Thrown in the caller when a task threw on another thread. C++11 rethrows
+ * the first exception itself, C++98 has no way to carry it across threads.
+ */
+class task_error : public std::runtime_error {
+public:
+    task_error() : std::runtime_error( "ft::parallel: a task threw" ) {}
+};
+
+/* ---------------------------------- Lock ---------------------------------- */
+
+class _Lock {
+    pthread_mutex_t &_mutex;
+
+    _Lock( const _Lock & );
+    _Lock &operator=( const _Lock & );
+
+public:
+    explicit _Lock( pthread_mutex_t &mutex ) : _mutex( mutex ) {
+        pthread_mutex_lock( &_mutex );
+    }
+    ~_Lock() { pthread_mutex_unlock( &_mutex ); }
+};
+
+/* ---------------------------------- Task ---------------------------------- */
+
+/*
+ * The tasks of one thread_pool::run, which waits for pending to drop to 0.
+ * Tasks finish under the mutex: once the caller sees 0 no thread touches
+ * the join anymore, and it can go with the caller's stack.
+ */
+class _Join {
+    pthread_mutex_t    _mutex;
+    pthread_cond_t     _done;
+    std::size_t        _pending;
+    bool               _failed;
+#if __cplusplus >= 201103L
+    std::exception_ptr _error;
+#endif
+
+    _Join( const _Join & );
+    _Join &operator=( const _Join & );
+
+public:
+    explicit _Join( std::size_t n ) : _pending( n ), _failed( false ) {
+        pthread_mutex_init( &_mutex, 0 );
+        pthread_cond_init( &_done, 0 );
+    }
+    ~_Join() {
+        pthread_cond_destroy( &_done );
+        pthread_mutex_destroy( &_mutex );
+    }
+
+    /* From a catch block */
+    void fail() {
+        _Lock lock( _mutex );
+        if ( _failed ) { return; }
+        _failed = true;
+#if __cplusplus >= 201103L
+        _error = std::current_exception();
+#endif
+    }
+
+    void finish() {
+        _Lock lock( _mutex );
+        if ( !--_pending ) { pthread_cond_broadcast( &_done ); }
+    }
+
+    void wait() {
+        _Lock lock( _mutex );
+        while ( _pending ) { pthread_cond_wait( &_done, &_mutex ); }
+    }
+
+    void rethrow() const {
+        if ( !_failed ) { return; }
+#if __cplusplus >= 201103L
+        std::rethrow_exception( _error );
+#else
+        throw task_error();
+#endif
+    }
+};
+
+struct _Task {
+    void ( *run )( void *, std::size_t );
+    void       *body;
+    std::size_t index;
+    _Join      *join;
+
+    void operator()() const {
+        try {
+            run( body, index );
+        } catch ( ... ) {
+            join->fail();
+        }
+        join->finish();
+    }
+};
+
+/* ---------------------------------- Queue --------------------------------- */
+
+/*
+ * A worker's tasks. The worker pops the newest, thieves steal the oldest.
+ * Queues sit side by side in an array, the padding keeps each lock on its
+ * own cache line.
+ */
+struct _Queue {
+    pthread_mutex_t     mutex;
+    ft::vector< _Task > tasks;
+    std::size_t         head;
+    char                padding[64];
+
+    _Queue() : head( 0 ) { pthread_mutex_init( &mutex, 0 ); }
+    ~_Queue() { pthread_mutex_destroy( &mutex ); }
+
+    void push( const _Task &task ) {
+        _Lock lock( mutex );
+        tasks.push_back( task );
+    }
+
+    bool pop( _Task &task ) {
+        _Lock lock( mutex );
+        if ( head == tasks.size() ) { return false; }
+        task = tasks.back();
+        tasks.pop_back();
+        _reset();
+        return true;
+    }
+
+    bool steal( _Task &task ) {
+        _Lock lock( mutex );
+        if ( head == tasks.size() ) { return false; }
+        task = tasks[head++];
+        _reset();
+        return true;
+    }
+
+private:
+    _Queue( const _Queue & );
+    _Queue &operator=( const _Queue & );
+
+    void _reset() {
+        if ( head == tasks.size() ) {
+            tasks.clear();
+            head = 0;
+        }
+    }
+};
+
+/* ------------------------------- Thread pool ------------------------------ */
+
+inline std::size_t hardware_concurrency() {
+    long n = sysconf( _SC_NPROCESSORS_ONLN );
+    return n > 0 ? n : 1;
+}
+
+/*
+ * size() threads of execution: size() - 1 workers, and the thread calling
+ * run, which works through the queues too until its tasks are done. Idle
+ * workers steal from the others' queues, then sleep until tasks come in.
+ * Any number of threads can call run at once, and tasks can call it again.
+ */
+class thread_pool {
+
+    /* ------------------------------- Attributes ------------------------------- */
+
+    struct _Worker {
+        _Queue       queue;
+        thread_pool *pool;
+        std::size_t  index;
+        pthread_t    thread;
+    };
+
+    _Worker        *_workers;
+    std::size_t     _n_workers;
+    std::size_t     _next;
+    long            _queued;
+    bool            _stop;
+    pthread_mutex_t _mutex;
+    pthread_cond_t  _wake;
+
+    thread_pool( const thread_pool & );
+    thread_pool &operator=( const thread_pool & );
+
+    /* ------------------------------ Construction ------------------------------ */
+
+public:
+    explicit thread_pool( std::size_t threads = hardware_concurrency() )
+        : _workers( 0 ),
+          _n_workers( 0 ),
+          _next( 0 ),
+          _queued( 0 ),
+          _stop( false ) {
+        pthread_mutex_init( &_mutex, 0 );
+        pthread_cond_init( &_wake, 0 );
+        if ( threads < 2 ) { return; }
+        _workers   = new _Worker[threads - 1];
+        _n_workers = threads - 1;
+        for ( std::size_t i = 0; i < _n_workers; i++ ) {
+            _Worker &w = _workers[i];
+            w.pool     = this;
+            w.index    = i;
+            if ( pthread_create( &w.thread, 0, _work, &w ) ) {
+                _shutdown( i );
+                throw std::runtime_error( "ft::parallel: pthread_create" );
+            }
+        }
+    }
+
+    ~thread_pool() { _shutdown( _n_workers ); }
+
+    std::size_t size() const { return _n_workers + 1; }
+
+    /* ----------------------------------- Run ---------------------------------- */
+
+    /*
+     * Calls f( i ) for every i below n, concurrently, and returns once all
+     * calls have. An exception escaping a call leaves the others running,
+     * then goes to the caller (see task_error).
+     */
+    template < typename F > void run( std::size_t n, F &f ) {
+        if ( !_n_workers || n < 2 ) {
+            for ( std::size_t i = 0; i < n; i++ ) { f( i ); }
+            return;
+        }
+        _Join join( n );
+        _Task task = { _call< F >,
+                       const_cast< void * >(
+                           static_cast< const void * >( &f ) ),
+                       0,
+                       &join };
+        __sync_add_and_fetch( &_queued, long( n ) );
+        {
+            _Lock lock( _mutex );
+            for ( ; task.index < n; task.index++ ) {
+                _workers[_next++ % _n_workers].queue.push( task );
+            }
+            pthread_cond_broadcast( &_wake );
+        }
+        while ( _take( task, _n_workers ) ) { task(); }
+        join.wait();
+        join.rethrow();
+    }
+
+    /* --------------------------------- Workers -------------------------------- */
+
+private:
+    template < typename F > static void _call( void *f, std::size_t i ) {
+        ( *static_cast< F * >( f ) )( i );
+    }
+
+    /* Own queue first, then the others from the next one on */
+    bool _take( _Task &task, std::size_t self ) {
+        bool found = self < _n_workers && _workers[self].queue.pop( task );
+        for ( std::size_t i = 1; !found && i <= _n_workers; i++ ) {
+            found = _workers[( self + i ) % _n_workers].queue.steal( task );
+        }
+        if ( found ) { __sync_sub_and_fetch( &_queued, 1 ); }
+        return found;
+    }
+
+    static void *_work( void *p ) {
+        _Worker     &w    = *static_cast< _Worker * >( p );
+        thread_pool &pool = *w.pool;
+        _Task        task;
+
+        for ( ;; ) {
+            if ( pool._take( task, w.index ) ) {
+                task();
+                continue;
+            }
+            _Lock lock( pool._mutex );
+            while ( !pool._stop
+                    && __sync_fetch_and_add( &pool._queued, 0 ) <= 0 ) {
+                pthread_cond_wait( &pool._wake, &pool._mutex );
+            }
+            if ( pool._stop ) { return 0; }
+        }
+    }
+
+    /* Stops and joins the first started workers */
+    void _shutdown( std::size_t started ) {
+        {
+            _Lock lock( _mutex );
+            _stop = true;
+            pthread_cond_broadcast( &_wake );
+        }
+        for ( std::size_t i = 0; i < started; i++ ) {
+            pthread_join( _workers[i].thread, 0 );
+        }
+        delete[] _workers;
+        pthread_cond_destroy( &_wake );
+        pthread_mutex_destroy( &_mutex );
+    }
+};
+
+/* One worker per core but the caller's, started on first use */
+inline thread_pool &default_pool() {
+    static thread_pool pool;
+    return pool;
+}
+
+/* --------------------------------- Chunks --------------------------------- */
+
+/*
+ * n elements in chunks of grain. A grain of 0 picks one giving every thread
+ * four chunks, so that there is something left to steal from slow ones.
+ */
+struct _Chunks {
+    std::size_t n;
+    std::size_t size;
+    std::size_t count;
+
+    _Chunks( const thread_pool &pool, std::size_t n, std::size_t grain )
+        : n( n ), size( grain ) {
+        if ( !size ) {
+            std::size_t parts = pool.size() > 1 ? pool.size() * 4 : 1;
+            size = std::max< std::size_t >( ( n + parts - 1 ) / parts, 1 );
+        }
+        count = ( n + size - 1 ) / size;
+    }
+
+    std::size_t begin( std::size_t i ) const { return i * size; }
+    std::size_t end( std::size_t i ) const {
+        return std::min( n, ( i + 1 ) * size );
+    }
+};
+
+/*
+ * Chunks walk contiguous ranges through plain pointers, loops over those
+ * optimize better than over iterator classes. Not for empty ranges, their
+ * first iterator cannot be dereferenced.
+ */
+template < typename I, bool = is_contiguous_iterator< I >::value >
+struct _Plain {
+    typedef I type;
+    static type get( I it ) { return it; }
+};
+
+template < typename I > struct _Plain< I, true > {
+    typedef typename iterator_traits< I >::pointer type;
+    static type get( I it ) { return &*it; }
+};
+
+template < typename I > typename _Plain< I >::type _plain( I it ) {
+    return _Plain< I >::get( it );
+}
+
+/* -------------------------------- For each -------------------------------- */
+
+template < typename RandomIt, typename Function > struct _For_each {
+    RandomIt first;
+    Function f;
+    _Chunks  chunks;
+
+    void operator()( std::size_t i ) {
+        std::for_each( first + chunks.begin( i ), first + chunks.end( i ), f );
+    }
+};
+
+template < typename RandomIt, typename Function >
+void for_each( thread_pool &pool,
+               RandomIt     first,
+               RandomIt     last,
+               Function     f,
+               std::size_t  grain = 0 ) {
+    typedef typename _Plain< RandomIt >::type plain;
+
+    if ( first == last ) { return; }
+    _For_each< plain, Function > body
+        = { _plain( first ), f, _Chunks( pool, last - first, grain ) };
+    pool.run( body.chunks.count, body );
+}
+
+template < typename RandomIt, typename Function >
+void for_each( RandomIt first, RandomIt last, Function f ) {
+    parallel::for_each( default_pool(), first, last, f );
+}
+
+/* -------------------------------- Transform ------------------------------- */
+
+template < typename RandomIt, typename OutputIt, typename UnaryOperation >
+struct _Transform {
+    RandomIt       first;
+    OutputIt       dst;
+    UnaryOperation op;
+    _Chunks        chunks;
+
+    void operator()( std::size_t i ) {
+        std::transform( first + chunks.begin( i ),
+                        first + chunks.end( i ),
+                        dst + chunks.begin( i ),
+                        op );
+    }
+};
+
+/* dst is random access as well, each chunk writes its own part of it */
+template < typename RandomIt, typename OutputIt, typename UnaryOperation >
+OutputIt transform( thread_pool   &pool,
+                    RandomIt       first,
+                    RandomIt       last,
+                    OutputIt       dst,
+                    UnaryOperation op,
+                    std::size_t    grain = 0 ) {
+    typedef typename _Plain< RandomIt >::type plain;
+    typedef typename _Plain< OutputIt >::type plain_dst;
+
+    if ( first == last ) { return dst; }
+    _Transform< plain, plain_dst, UnaryOperation > body
+        = { _plain( first ),
+            _plain( dst ),
+            op,
+            _Chunks( pool, last - first, grain ) };
+    pool.run( body.chunks.count, body );
+    return dst + ( last - first );
+}
+
+template < typename RandomIt, typename OutputIt, typename UnaryOperation >
+OutputIt
+transform( RandomIt first, RandomIt last, OutputIt dst, UnaryOperation op ) {
+    return parallel::transform( default_pool(), first, last, dst, op );
+}
+
+/* --------------------------------- Reduce --------------------------------- */
+
+template < typename RandomIt, typename T, typename BinaryOperation >
+struct _Reduce {
+    RandomIt         first;
+    BinaryOperation  op;
+    _Chunks          chunks;
+    ft::vector< T > &partials;
+
+    void operator()( std::size_t i ) {
+        RandomIt it( first + chunks.begin( i ) );
+        RandomIt last( first + chunks.end( i ) );
+        T        acc( *it );
+        for ( it++; it != last; it++ ) { acc = op( acc, *it ); }
+        partials[i] = acc;
+    }
+};
+
+/*
+ * Chunks fold on their own, then their results fold into init in order:
+ * op has to be associative, not commutative.
+ */
+template < typename RandomIt, typename T, typename BinaryOperation >
+T reduce( thread_pool    &pool,
+          RandomIt        first,
+          RandomIt        last,
+          T               init,
+          BinaryOperation op,
+          std::size_t     grain = 0 ) {
+    typedef typename _Plain< RandomIt >::type plain;
+
+    if ( first == last ) { return init; }
+    _Chunks         chunks( pool, last - first, grain );
+    ft::vector< T > partials( chunks.count, init );
+    _Reduce< plain, T, BinaryOperation > body
+        = { _plain( first ), op, chunks, partials };
+    pool.run( chunks.count, body );
+    for ( std::size_t i = 0; i < chunks.count; i++ ) {
+        init = op( init, partials[i] );
+    }
+    return init;
+}
+
+template < typename RandomIt, typename T, typename BinaryOperation >
+T reduce( RandomIt first, RandomIt last, T init, BinaryOperation op ) {
+    return parallel::reduce( default_pool(), first, last, init, op );
+}
+
+template < typename RandomIt, typename T >
+T reduce( RandomIt first, RandomIt last, T init ) {
+    return parallel::reduce( first, last, init, std::plus< T >() );
+}
+
+/* ---------------------------------- Copy ---------------------------------- */
+
+template < typename RandomIt, typename OutputIt > struct _Copy {
+    RandomIt first;
+    OutputIt dst;
+    _Chunks  chunks;
+
+    void operator()( std::size_t i ) {
+        ft::copy( first + chunks.begin( i ),
+                  first + chunks.end( i ),
+                  dst + chunks.begin( i ) );
+    }
+};
+
+template < typename RandomIt, typename OutputIt >
+OutputIt copy( thread_pool &pool,
+               RandomIt     first,
+               RandomIt     last,
+               OutputIt     dst,
+               std::size_t  grain = 0 ) {
+    typedef typename _Plain< RandomIt >::type plain;
+    typedef typename _Plain< OutputIt >::type plain_dst;
+
+    if ( first == last ) { return dst; }
+    _Copy< plain, plain_dst > body
+        = { _plain( first ),
+            _plain( dst ),
+            _Chunks( pool, last - first, grain ) };
+    pool.run( body.chunks.count, body );
+    return dst + ( last - first );
+}
+
+template < typename RandomIt, typename OutputIt >
+OutputIt copy( RandomIt first, RandomIt last, OutputIt dst ) {
+    return parallel::copy( default_pool(), first, last, dst );
+}
+
+/* ---------------------------------- Fill ---------------------------------- */
+
+template < typename RandomIt, typename T > struct _Fill {
+    RandomIt first;
+    const T &value;
+    _Chunks  chunks;
+
+    void operator()( std::size_t i ) {
+        ft::fill( first + chunks.begin( i ), first + chunks.end( i ), value );
+    }
+};
+
+template < typename RandomIt, typename T >
+void fill( thread_pool &pool,
+           RandomIt     first,
+           RandomIt     last,
+           const T     &value,
+           std::size_t  grain = 0 ) {
+    typedef typename _Plain< RandomIt >::type plain;
+
+    if ( first == last ) { return; }
+    _Fill< plain, T > body
+        = { _plain( first ), value, _Chunks( pool, last - first, grain ) };
+    pool.run( body.chunks.count, body );
+}
+
+template < typename RandomIt, typename T >
+void fill( RandomIt first, RandomIt last, const T &value ) {
+    parallel::fill( default_pool(), first, last, value );
+}
+
+/* --------------------------- Uninitialized copy --------------------------- */
+
+template < typename RandomIt, typename OutputIt > struct _Uninitialized_copy {
+    RandomIt            first;
+    OutputIt            dst;
+    _Chunks             chunks;
+    ft::vector< char > &done;
+
+    void operator()( std::size_t i ) {
+        std::uninitialized_copy( first + chunks.begin( i ),
+                                 first + chunks.end( i ),
+                                 dst + chunks.begin( i ) );
+        done[i] = true;
+    }
+};
+
+/* A chunk that throws undoes itself, the others are destroyed after */
+template < typename RandomIt, typename OutputIt >
+OutputIt uninitialized_copy( thread_pool &pool,
+                             RandomIt     first,
+                             RandomIt     last,
+                             OutputIt     dst,
+                             std::size_t  grain = 0 ) {
+    typedef typename _Plain< RandomIt >::type plain;
+    typedef typename _Plain< OutputIt >::type plain_dst;
+
+    if ( first == last ) { return dst; }
+    _Chunks            chunks( pool, last - first, grain );
+    ft::vector< char > done( chunks.count, false );
+    _Uninitialized_copy< plain, plain_dst > body
+        = { _plain( first ), _plain( dst ), chunks, done };
+    try {
+        pool.run( chunks.count, body );
+    } catch ( ... ) {
+        for ( std::size_t i = 0; i < chunks.count; i++ ) {
+            if ( done[i] ) {
+                ft::_destroy( dst + chunks.begin( i ), dst + chunks.end( i ) );
+            }
+        }
+        throw;
+    }
+    return dst + ( last - first );
+}
+
+template < typename RandomIt, typename OutputIt >
+OutputIt uninitialized_copy( RandomIt first, RandomIt last, OutputIt dst ) {
+    return parallel::uninitialized_copy( default_pool(), first, last, dst );
+}
+
+/* ---------------------------------- Sort ---------------------------------- */
+
+/* Scratch space as long as the range, copied from it in parallel */
+template < typename T > class _Buffer {
+    std::allocator< T > _allocator;
+    T                  *_data;
+    std::size_t         _n;
+
+    _Buffer( const _Buffer & );
+    _Buffer &operator=( const _Buffer & );
+
+public:
+    template < typename RandomIt >
+    _Buffer( thread_pool &pool, RandomIt first, RandomIt last )
+        : _data( _allocator.allocate( last - first ) ),
+          _n( last - first ) {
+        try {
+            parallel::uninitialized_copy( pool, first, last, _data );
+        } catch ( ... ) {
+            _allocator.deallocate( _data, _n );
+            throw;
+        }
+    }
+    ~_Buffer() {
+        ft::_destroy( _data, _data + _n );
+        _allocator.deallocate( _data, _n );
+    }
+
+    T *data() const { return _data; }
+};
+
+template < typename RandomIt, typename Compare > struct _Sort_chunk {
+    RandomIt first;
+    Compare  comp;
+    _Chunks  chunks;
+
+    void operator()( std::size_t i ) {
+        std::sort( first + chunks.begin( i ), first + chunks.end( i ), comp );
+    }
+};
+
+/*
+ * One round of merging sorted runs of width into runs of twice that, from
+ * src to dst. Each pair of runs is cut every grain elements of its left
+ * run, the right run where lower_bound puts that element: pieces merge on
+ * their own and land right after one another.
+ */
+template < typename Src, typename Dst, typename Compare > struct _Merge {
+    Src         src;
+    Dst         dst;
+    Compare     comp;
+    std::size_t n;
+    std::size_t width;
+    std::size_t grain;
+    std::size_t pieces;
+
+    std::size_t
+    _cut( std::size_t i, std::size_t lo, std::size_t mid, std::size_t hi ) {
+        if ( i == lo ) { return mid; }
+        return std::lower_bound( src + mid, src + hi, src[i], comp ) - src;
+    }
+
+    void operator()( std::size_t i ) {
+        std::size_t lo  = i / pieces * 2 * width;
+        std::size_t mid = std::min( lo + width, n );
+        std::size_t hi  = std::min( lo + 2 * width, n );
+        std::size_t a   = lo + i % pieces * grain;
+        if ( a >= mid ) { return; }
+        std::size_t b  = std::min( a + grain, mid );
+        std::size_t ja = _cut( a, lo, mid, hi );
+        std::size_t jb = b == mid ? hi : _cut( b, lo, mid, hi );
+        std::merge( src + a,
+                    src + b,
+                    src + ja,
+                    src + jb,
+                    dst + ( a + ja - mid ),
+                    comp );
+    }
+};
+
+template < typename Src, typename Dst, typename Compare >
+void _merge( thread_pool   &pool,
+             Src            src,
+             Dst            dst,
+             Compare        comp,
+             const _Chunks &chunks,
+             std::size_t    width ) {
+    std::size_t pairs  = ( chunks.n + 2 * width - 1 ) / ( 2 * width );
+    std::size_t pieces = ( width + chunks.size - 1 ) / chunks.size;
+    _Merge< Src, Dst, Compare > body
+        = { src, dst, comp, chunks.n, width, chunks.size, pieces };
+    pool.run( pairs * pieces, body );
+}
+
+template < typename RandomIt, typename Compare >
+void _sort( thread_pool   &pool,
+            RandomIt       first,
+            const _Chunks &chunks,
+            Compare        comp ) {
+    typedef typename iterator_traits< RandomIt >::value_type value_type;
+
+    _Sort_chunk< RandomIt, Compare > body = { first, comp, chunks };
+    pool.run( chunks.count, body );
+
+    _Buffer< value_type > buffer( pool, first, first + chunks.n );
+    bool                  in_buffer = false;
+    for ( std::size_t width = chunks.size; width < chunks.n; width *= 2 ) {
+        if ( in_buffer ) {
+            _merge( pool, buffer.data(), first, comp, chunks, width );
+        } else {
+            _merge( pool, first, buffer.data(), comp, chunks, width );
+        }
+        in_buffer = !in_buffer;
+    }
+    if ( in_buffer ) {
+        parallel::copy( pool,
+                        buffer.data(),
+                        buffer.data() + chunks.n,
+                        first,
+                        chunks.size );
+    }
+}
+
+/*
+ * Chunks sort on their own, then merge rounds go back and forth between
+ * the range and a buffer as long as it. Not stable, as std::sort.
+ */
+template < typename RandomIt, typename Compare >
+void sort( thread_pool &pool,
+           RandomIt     first,
+           RandomIt     last,
+           Compare      comp,
+           std::size_t  grain = 0 ) {
+    _Chunks chunks( pool, last - first, grain );
+    if ( chunks.count < 2 ) {
+        std::sort( first, last, comp );
+        return;
+    }
+    _sort( pool, _plain( first ), chunks, comp );
+}
+
+template < typename RandomIt >
+void sort( thread_pool &pool, RandomIt first, RandomIt last ) {
+    typedef typename iterator_traits< RandomIt >::value_type value_type;
+    parallel::sort( pool, first, last, std::less< value_type >() );
+}
+
+template < typename RandomIt, typename Compare >
+void sort( RandomIt first, RandomIt last, Compare comp ) {
+    parallel::sort( default_pool(), first, last, comp );
+}
+
+template < typename RandomIt > void sort( RandomIt first, RandomIt last ) {
+    typedef typename iterator_traits< RandomIt >::value_type value_type;
+    parallel::sort( first, last, std::less< value_type >() );
+}
+
+/* -------------------------------------------------------------------------- */
+
+}
+}
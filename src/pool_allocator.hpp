@@ -0,0 +1,262 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <sched.h>
+
+namespace ft {
+
+/* ---------------------------------- Stats --------------------------------- */
+
+struct pool_stats {
+    std::size_t slabs;
+    std::size_t live;
+    std::size_t free;
+};
+
+/* ---------------------------------- Pool ---------------------------------- */
+
+enum { _POOL_SLAB_SIZE = 1 << 16 };
+
+/* Held for a few instructions at a time: spins, yielding if it has to */
+class _Pool_lock {
+    int &_flag;
+
+    _Pool_lock( const _Pool_lock & );
+    _Pool_lock &operator=( const _Pool_lock & );
+
+public:
+    explicit _Pool_lock( int &flag ) : _flag( flag ) {
+        while ( __atomic_exchange_n( &_flag, 1, __ATOMIC_ACQUIRE ) ) {
+            while ( __atomic_load_n( &_flag, __ATOMIC_RELAXED ) ) {
+                sched_yield();
+            }
+        }
+    }
+    ~_Pool_lock() { __atomic_store_n( &_flag, 0, __ATOMIC_RELEASE ); }
+};
+
+/*
+ * Fixed-size chunks carved out of SLAB_SIZE-aligned slabs, so the slab
+ * owning a chunk is found by masking its address. One pool per chunk size
+ * is shared by every pool_allocator, which keeps the allocators stateless.
+ * Containers on different threads share it too: a lock guards every call.
+ */
+template < std::size_t Size > class _Node_pool {
+    struct _Slab {
+        _Slab      *next;
+        std::size_t used;
+        std::size_t padding[2];
+    };
+    struct _Chunk {
+        _Chunk *next;
+    };
+
+public:
+    enum {
+        SLAB_SIZE = _POOL_SLAB_SIZE,
+        CHUNKS    = ( SLAB_SIZE - sizeof( _Slab ) ) / Size,
+    };
+
+private:
+    _Slab      *_slabs;
+    _Chunk     *_free;
+    std::size_t _n_slabs;
+    std::size_t _n_live;
+    std::size_t _n_free;
+    mutable int _lock;
+
+    _Node_pool()
+        : _slabs( 0 ),
+          _free( 0 ),
+          _n_slabs( 0 ),
+          _n_live( 0 ),
+          _n_free( 0 ),
+          _lock( 0 ) {}
+    _Node_pool( const _Node_pool & );
+    _Node_pool &operator=( const _Node_pool & );
+
+    static _Slab *_slab_of( void *p ) {
+        return reinterpret_cast< _Slab * >(
+            reinterpret_cast< std::size_t >( p )
+            & ~static_cast< std::size_t >( SLAB_SIZE - 1 ) );
+    }
+
+    void _grow() {
+        void *p;
+        if ( posix_memalign( &p, SLAB_SIZE, SLAB_SIZE ) ) {
+            throw std::bad_alloc();
+        }
+        _Slab *slab = static_cast< _Slab * >( p );
+        slab->next  = _slabs;
+        slab->used  = 0;
+        _slabs      = slab;
+        _n_slabs++;
+        char *chunk = reinterpret_cast< char * >( slab + 1 ) + CHUNKS * Size;
+        for ( std::size_t i = 0; i < CHUNKS; i++ ) {
+            chunk -= Size;
+            reinterpret_cast< _Chunk * >( chunk )->next = _free;
+            _free = reinterpret_cast< _Chunk * >( chunk );
+        }
+        _n_free += CHUNKS;
+    }
+
+public:
+    /*
+     * Never destroyed: a map with static storage built before the pool is
+     * destroyed after it, and still hands its nodes back on the way out.
+     */
+    static _Node_pool &instance() {
+        static _Node_pool *pool = new _Node_pool;
+        return *pool;
+    }
+
+    void *allocate() {
+        _Pool_lock lock( _lock );
+        if ( !_free ) { _grow(); }
+        _Chunk *chunk = _free;
+        _free         = chunk->next;
+        _slab_of( chunk )->used++;
+        _n_free--;
+        _n_live++;
+        return chunk;
+    }
+
+    void deallocate( void *p ) {
+        _Pool_lock lock( _lock );
+        _Chunk *chunk = static_cast< _Chunk * >( p );
+        chunk->next   = _free;
+        _free         = chunk;
+        _slab_of( chunk )->used--;
+        _n_free++;
+        _n_live--;
+    }
+
+    /* Frees the slabs without live chunks, returns how many were freed */
+    std::size_t release() {
+        _Pool_lock lock( _lock );
+        _Chunk **chunk = &_free;
+        while ( *chunk ) {
+            if ( !_slab_of( *chunk )->used ) {
+                *chunk = ( *chunk )->next;
+                _n_free--;
+            } else {
+                chunk = &( *chunk )->next;
+            }
+        }
+        std::size_t released = 0;
+        _Slab     **slab     = &_slabs;
+        while ( *slab ) {
+            if ( !( *slab )->used ) {
+                _Slab *empty = *slab;
+                *slab        = empty->next;
+                std::free( empty );
+                released++;
+            } else {
+                slab = &( *slab )->next;
+            }
+        }
+        _n_slabs -= released;
+        return released;
+    }
+
+    pool_stats stats() const {
+        _Pool_lock lock( _lock );
+        pool_stats stats = { _n_slabs, _n_live, _n_free };
+        return stats;
+    }
+};
+
+/* -------------------------------- Allocator ------------------------------- */
+
+template < typename T > class pool_allocator;
+
+template <> class pool_allocator< void > {
+public:
+    typedef void              value_type;
+    typedef value_type       *pointer;
+    typedef const value_type *const_pointer;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+
+    template < typename U > struct rebind {
+        typedef pool_allocator< U > other;
+    };
+};
+
+/*
+ * Single objects come from the pool of their rounded size, anything else
+ * (arrays, objects too large to fit a slab several times) from operator new.
+ */
+template < typename T > class pool_allocator {
+public:
+    typedef T                 value_type;
+    typedef value_type       &reference;
+    typedef const value_type &const_reference;
+    typedef value_type       *pointer;
+    typedef const value_type *const_pointer;
+    typedef std::size_t       size_type;
+    typedef std::ptrdiff_t    difference_type;
+
+    template < typename U > struct rebind {
+        typedef pool_allocator< U > other;
+    };
+
+private:
+    enum {
+        CHUNK_SIZE = ( sizeof( T ) + sizeof( void * ) - 1 )
+                     & ~( sizeof( void * ) - 1 ),
+        POOLED = CHUNK_SIZE * 8 <= _POOL_SLAB_SIZE,
+    };
+
+    typedef _Node_pool< CHUNK_SIZE > pool_type;
+
+public:
+    pool_allocator() throw() {}
+    pool_allocator( const pool_allocator & ) throw() {}
+    template < typename U >
+    pool_allocator( const pool_allocator< U > & ) throw() {}
+
+    pointer allocate( size_type n, pool_allocator< void >::const_pointer = 0 ) {
+        if ( POOLED && n == 1 ) {
+            return static_cast< pointer >( pool_type::instance().allocate() );
+        }
+        if ( n > max_size() ) { throw std::bad_alloc(); }
+        return static_cast< pointer >( ::operator new( n * sizeof( T ) ) );
+    }
+    void deallocate( pointer p, size_type n ) {
+        if ( POOLED && n == 1 ) {
+            pool_type::instance().deallocate( p );
+        } else {
+            ::operator delete( p );
+        }
+    }
+
+    void construct( pointer p, const_reference val ) { ::new ( p ) T( val ); }
+    void destroy( pointer p ) { p->~T(); }
+
+    size_type max_size() const throw() {
+        return std::numeric_limits< size_type >::max() / sizeof( T );
+    }
+    pointer       address( reference x ) const { return &x; }
+    const_pointer address( const_reference x ) const { return &x; }
+
+    /* Shared by every allocator whose value_type has the same chunk size */
+    static pool_stats  stats() { return pool_type::instance().stats(); }
+    static std::size_t release() { return pool_type::instance().release(); }
+};
+
+template < typename T, typename U >
+bool operator==( const pool_allocator< T > &, const pool_allocator< U > & ) {
+    return true;
+}
+template < typename T, typename U >
+bool operator!=( const pool_allocator< T > &, const pool_allocator< U > & ) {
+    return false;
+}
+
+/* -------------------------------------------------------------------------- */
+
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "type_traits.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+
+namespace ft {
+
+/*
+ * A d-ary max-heap over Container, Arity children per node. With 4 or 8
+ * the tree is half or a third as deep as a binary one and siblings share a
+ * cache line: pop moves fewer elements and touches fewer lines, for more
+ * comparisons. That pays off for heaps larger than the caches or elements
+ * costly to move; small keys in cache do best with the binary default.
+ */
+template < typename T,
+           typename Container = vector< T >,
+           typename Compare   = std::less< typename Container::value_type >,
+           std::size_t Arity  = 2 >
+class priority_queue {
+
+    typedef char _Arity_at_least_two[Arity >= 2 ? 1 : -1];
+
+    /* ------------------------------ Member types ------------------------------ */
+
+public:
+    typedef Container                                container_type;
+    typedef Compare                                  value_compare;
+    typedef typename container_type::value_type      value_type;
+    typedef typename container_type::size_type       size_type;
+    typedef typename container_type::reference       reference;
+    typedef typename container_type::const_reference const_reference;
+
+    /* ------------------------------- Attributes ------------------------------- */
+
+protected:
+    container_type c;
+    value_compare  comp;
+
+    /* ------------------------------ Construction ------------------------------ */
+
+public:
+    explicit priority_queue( const value_compare  &comp = value_compare(),
+                             const container_type &c    = container_type() )
+        : c( c ),
+          comp( comp ) {
+        _make_heap();
+    }
+
+    template < typename InputIterator >
+    priority_queue( InputIterator         first,
+                    InputIterator         last,
+                    const value_compare  &comp = value_compare(),
+                    const container_type &c    = container_type() )
+        : c( c ),
+          comp( comp ) {
+        this->c.insert( this->c.end(), first, last );
+        _make_heap();
+    }
+
+    /* -------------------------------- Capacity -------------------------------- */
+
+    bool      empty() const { return c.empty(); }
+    size_type size() const { return c.size(); }
+
+    /* ----------------------------- Element access ----------------------------- */
+
+    const_reference top() const { return c.front(); }
+
+    /* -------------------------------- Modifiers ------------------------------- */
+
+    void push( const value_type &val ) {
+        c.push_back( val );
+        value_type tmp( ft::_move( c.back() ) );
+        _sift_up( c.size() - 1, 0, tmp );
+    }
+
+#if __cplusplus >= 201103L
+    void push( value_type &&val ) { emplace( std::move( val ) ); }
+
+    template < typename... Args > void emplace( Args &&...args ) {
+        c.emplace_back( std::forward< Args >( args )... );
+        value_type tmp( std::move( c.back() ) );
+        _sift_up( c.size() - 1, 0, tmp );
+    }
+#endif
+
+    /*
+     * Appends the range, then either sifts each new element up or heapifies
+     * everything in O(n), whichever bounds the work better: sifting costs up
+     * to one level of the tree per element, heapifying one pass over all.
+     */
+    template < typename InputIterator >
+    void push_range( InputIterator first, InputIterator last ) {
+        size_type n = c.size();
+        c.insert( c.end(), first, last );
+        size_type len = c.size();
+        if ( ( len - n ) * _depth( len ) >= len ) {
+            _make_heap();
+            return;
+        }
+        for ( ; n < len; n++ ) {
+            value_type tmp( ft::_move( c[n] ) );
+            _sift_up( n, 0, tmp );
+        }
+    }
+
+    /* The last element refills the root's hole from the bottom up */
+    void pop() {
+        if ( c.empty() ) { return; }
+        size_type n = c.size() - 1;
+        if ( n ) {
+            value_type tmp( ft::_move( c[n] ) );
+            _adjust( 0, n, tmp );
+        }
+        c.pop_back();
+    }
+
+    void swap( priority_queue &other ) {
+        c.swap( other.c );
+        ft::swap( comp, other.comp );
+    }
+
+    /* ---------------------------------- Heap ---------------------------------- */
+
+    /*
+     * The root has children 1 to Arity - 1, any other node i has i * Arity
+     * to i * Arity + Arity - 1: each family starts at a multiple of Arity,
+     * so with an aligned buffer it never straddles two cache lines.
+     */
+
+private:
+    template < size_type N >
+    struct _Width : integral_constant< size_type, N > {};
+
+    /* Levels of a heap of n elements */
+    static size_type _depth( size_type n ) {
+        size_type depth = 1;
+        for ( ; n >= Arity; n /= Arity ) { depth++; }
+        return depth;
+    }
+
+    /* The best of N siblings, a tournament so that comparisons overlap */
+    template < size_type N > size_type _best( size_type first, _Width< N > ) {
+        size_type a = _best( first, _Width< N / 2 >() );
+        size_type b = _best( first + N / 2, _Width< N - N / 2 >() );
+        return comp( c[a], c[b] ) ? b : a;
+    }
+    size_type _best( size_type first, _Width< 1 > ) { return first; }
+
+    /* Asks for the grandchildren of the node whose family starts at i */
+    void _prefetch( size_type i, size_type n ) {
+#ifdef __GNUC__
+        if ( i < n ) { __builtin_prefetch( &c[i] ); }
+#else
+        ( void )i;
+        ( void )n;
+#endif
+    }
+
+    /* Moves the hole at i up while val beats its parent, never above top */
+    void _sift_up( size_type i, size_type top, value_type &val ) {
+        while ( i > top ) {
+            size_type parent = i / Arity;
+            if ( !comp( c[parent], val ) ) { break; }
+            c[i] = ft::_move( c[parent] );
+            i    = parent;
+        }
+        c[i] = ft::_move( val );
+    }
+
+    /*
+     * Fills the hole at i, within the first n elements, with val. The hole
+     * sinks to a leaf along the largest children, then val climbs back: it
+     * usually came from the bottom and belongs there, so this spares the
+     * comparison with val on the way down.
+     */
+    void _adjust( size_type i, size_type n, value_type &val ) {
+        size_type top = i;
+        size_type first;
+        for ( ; ( first = i ? i * Arity : 1 ) < n; ) {
+            size_type child = first;
+            _prefetch( first * Arity, n );
+            if ( i && n - first >= Arity ) {
+                child = _best( first, _Width< Arity >() );
+            } else {
+                size_type last = std::min( i * Arity + Arity, n );
+                for ( size_type j = first + 1; j < last; j++ ) {
+                    child = comp( c[child], c[j] ) ? j : child;
+                }
+            }
+            c[i] = ft::_move( c[child] );
+            i    = child;
+        }
+        _sift_up( i, top, val );
+    }
+
+    /* Floyd's heapify, every parent from the last one back to the root */
+    void _make_heap() {
+        size_type n = c.size();
+        if ( n < 2 ) { return; }
+        for ( size_type i = ( n - 1 ) / Arity + 1; i--; ) {
+            value_type tmp( ft::_move( c[i] ) );
+            _adjust( i, n, tmp );
+        }
+    }
+};
+
+/* ---------------------------------- Swap ---------------------------------- */
+
+template < typename T, typename C, typename Compare, std::size_t Arity >
+void swap( priority_queue< T, C, Compare, Arity > &x,
+           priority_queue< T, C, Compare, Arity > &y ) {
+    x.swap( y );
+}
+
+/* -------------------------------------------------------------------------- */
+
+}
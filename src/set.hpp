@@ -8,19 +8,14 @@ namespace ft {
 
 template < typename T,
            typename Compare = std::less< T >,
-           typename Alloc   = std::allocator< T > >
+           typename Alloc   = FT_TREE_ALLOCATOR< T > >
 class set {
 
     /* ------------------------------ Member types ------------------------------ */
 
-    typedef _Rb_tree<
-        T,
-        T,
-        Compare,
-        typename Alloc::template rebind< ft::pair< const T, T > >::other >
-                                               tree_type;
-    typedef typename tree_type::iterator       tree_iterator;
-    typedef typename tree_type::const_iterator tree_const_iterator;
+    typedef _Rb_tree< T, void, Compare, Alloc > tree_type;
+    typedef typename tree_type::iterator        tree_iterator;
+    typedef typename tree_type::const_iterator  tree_const_iterator;
 
 public:
     typedef typename tree_type::key_type             key_type;
@@ -69,8 +64,8 @@ public:
         }
         Iterator operator--( int ) { return _it--; }
 
-        reference operator*() const { return _it->second; }
-        pointer   operator->() const { return &_it->second; }
+        reference operator*() const { return *_it; }
+        pointer   operator->() const { return _it.operator->(); }
 
         bool operator==( const Iterator &other ) const {
             return _it == other._it;
@@ -149,17 +144,15 @@ public:
     /* -------------------------------- Modifiers ------------------------------- */
 
     ft::pair< iterator, bool > insert( const value_type &val ) {
-        return _tree.insert( ft::make_pair( val, val ) );
+        return _tree.insert( val );
     }
     iterator insert( iterator position, const value_type &val ) {
-        return _tree
-            .insert( tree_const_iterator( position ).get_node(),
-                     ft::make_pair( val, val ) )
+        return _tree.insert( tree_const_iterator( position ).get_node(), val )
             .first;
     }
     template < class InputIterator >
     void insert( InputIterator first, InputIterator last ) {
-        for ( ; first != last; first++ ) { insert( *first ); }
+        _tree.insert( first, last );
     }
 
     void      erase( iterator position ) { _tree.erase( *position ); }
@@ -172,6 +165,9 @@ public:
             first = next;
         }
     }
+    template < typename Predicate > size_type erase_if( Predicate pred ) {
+        return _tree.erase_if( pred );
+    }
 
     void swap( set &other ) { ft::swap( _tree, other._tree ); }
 
@@ -195,8 +191,7 @@ public:
         return _tree.upper_bound( val );
     }
     pair< iterator, iterator > equal_range( const value_type &val ) const {
-        return ft::pair< iterator, iterator >( lower_bound( val ),
-                                               upper_bound( val ) );
+        return _tree.equal_range( val );
     }
 
     /* -------------------------------- Allocator ------------------------------- */
@@ -220,6 +215,14 @@ void swap( set< T, Compare, Alloc > &lhs, set< T, Compare, Alloc > &rhs ) {
     lhs.swap( rhs );
 }
 
+/* -------------------------------- Erase if -------------------------------- */
+
+template < typename T, typename Compare, typename Alloc, typename Predicate >
+typename set< T, Compare, Alloc >::size_type
+erase_if( set< T, Compare, Alloc > &c, Predicate pred ) {
+    return c.erase_if( pred );
+}
+
 /* -------------------------------------------------------------------------- */
 
 }
\ No newline at end of file
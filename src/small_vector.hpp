@@ -0,0 +1,285 @@
+#pragma once
+
+#include "vector.hpp"
+#include <cstddef>
+#include <memory>
+
+namespace ft {
+
+/*
+ * A vector keeping its first N elements inside the object, spilling to the
+ * allocator only past them. It has vector's interface and iterators, but is
+ * not a vector to anyone else: whatever takes one may steal its buffer, and
+ * an inline buffer cannot be stolen. Storage is aligned for scalar types
+ * only.
+ */
+template < typename T,
+           std::size_t N,
+           typename Allocator = std::allocator< T >,
+           typename Growth    = ft::growth_double >
+class small_vector : private vector< T, Allocator, Growth > {
+
+    /* ------------------------------ Member types ------------------------------ */
+
+    typedef vector< T, Allocator, Growth > base_type;
+
+public:
+    typedef typename base_type::value_type             value_type;
+    typedef typename base_type::allocator_type         allocator_type;
+    typedef typename base_type::reference              reference;
+    typedef typename base_type::const_reference        const_reference;
+    typedef typename base_type::pointer                pointer;
+    typedef typename base_type::const_pointer          const_pointer;
+    typedef typename base_type::iterator               iterator;
+    typedef typename base_type::const_iterator         const_iterator;
+    typedef typename base_type::reverse_iterator       reverse_iterator;
+    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename base_type::difference_type        difference_type;
+    typedef typename base_type::size_type              size_type;
+
+    /* ---------------------------- Vector interface ---------------------------- */
+
+    using base_type::size;
+    using base_type::max_size;
+    using base_type::resize;
+    using base_type::resize_and_overwrite;
+    using base_type::capacity;
+    using base_type::empty;
+    using base_type::reserve;
+
+    using base_type::begin;
+    using base_type::end;
+    using base_type::rbegin;
+    using base_type::rend;
+
+    using base_type::operator[];
+    using base_type::at;
+    using base_type::front;
+    using base_type::back;
+    using base_type::data;
+
+    using base_type::assign;
+    using base_type::push_back;
+#if __cplusplus >= 201103L
+    using base_type::emplace_back;
+    using base_type::emplace;
+#endif
+    using base_type::pop_back;
+    using base_type::insert;
+    using base_type::erase;
+    using base_type::erase_if;
+    using base_type::clear;
+
+    using base_type::get_allocator;
+
+    /* ------------------------------- Attributes ------------------------------- */
+
+private:
+    union _Storage {
+        char        bytes[N * sizeof( T )];
+        long double align_long_double;
+        long        align_long;
+        void       *align_pointer;
+    } _storage;
+
+    /* ------------------------------ Construction ------------------------------ */
+
+public:
+    explicit small_vector( const allocator_type &alloc = allocator_type() )
+        : base_type( alloc ) {
+        _use_storage();
+    }
+
+    explicit small_vector( size_type             n,
+                           const value_type     &val   = value_type(),
+                           const allocator_type &alloc = allocator_type() )
+        : base_type( alloc ) {
+        _use_storage();
+        try {
+            this->assign( n, val );
+        } catch ( ... ) {
+            _drop_storage();
+            throw;
+        }
+    }
+
+    template < class U >
+    small_vector(
+        U                     first,
+        U                     last,
+        const allocator_type &alloc = allocator_type(),
+        typename ft::enable_if< !ft::is_integral< U >::value, U >::type * = 0 )
+        : base_type( alloc ) {
+        _use_storage();
+        try {
+            this->assign( first, last );
+        } catch ( ... ) {
+            _drop_storage();
+            throw;
+        }
+    }
+
+    small_vector( const small_vector &other )
+        : base_type( other.get_allocator() ) {
+        _use_storage();
+        try {
+            this->assign( other.begin(), other.end() );
+        } catch ( ... ) {
+            _drop_storage();
+            throw;
+        }
+    }
+
+    small_vector( const base_type &other )
+        : base_type( other.get_allocator() ) {
+        _use_storage();
+        try {
+            this->assign( other.begin(), other.end() );
+        } catch ( ... ) {
+            _drop_storage();
+            throw;
+        }
+    }
+
+#if __cplusplus >= 201103L
+    /* Not noexcept: inline elements move one by one, and moves can throw */
+    small_vector( small_vector &&other )
+        : base_type( other.get_allocator() ) {
+        _use_storage();
+        try {
+            _take( other );
+        } catch ( ... ) {
+            _drop_storage();
+            throw;
+        }
+    }
+#endif
+
+    ~small_vector() { _drop_storage(); }
+
+    small_vector &operator=( const small_vector &other ) {
+        base_type::operator=( other );
+        return *this;
+    }
+
+    small_vector &operator=( const base_type &other ) {
+        base_type::operator=( other );
+        return *this;
+    }
+
+#if __cplusplus >= 201103L
+    small_vector &operator=( small_vector &&other ) {
+        _take( other );
+        return *this;
+    }
+#endif
+
+    /* -------------------------------- Capacity -------------------------------- */
+
+    static size_type inline_capacity() { return N; }
+
+    /* -------------------------------- Modifiers ------------------------------- */
+
+    /*
+     * O(1) between heap buffers. With an inline buffer on either side the
+     * elements move across one by one, which can throw.
+     */
+    void swap( small_vector &other ) {
+        if ( this->_is_inline() || other._is_inline() ) {
+            small_vector tmp( ft::_move( *this ) );
+            *this = ft::_move( other );
+            other = ft::_move( tmp );
+            return;
+        }
+        base_type::swap( other );
+    }
+
+    /* -------------------------- Relational operators -------------------------- */
+
+    bool operator==( const small_vector &other ) const {
+        return _base() == other._base();
+    }
+    bool operator!=( const small_vector &other ) const {
+        return _base() != other._base();
+    }
+    bool operator<( const small_vector &other ) const {
+        return _base() < other._base();
+    }
+    bool operator<=( const small_vector &other ) const {
+        return _base() <= other._base();
+    }
+    bool operator>( const small_vector &other ) const {
+        return _base() > other._base();
+    }
+    bool operator>=( const small_vector &other ) const {
+        return _base() >= other._base();
+    }
+
+    /* --------------------------------- Storage -------------------------------- */
+
+protected:
+    const_pointer _inline_storage() const {
+        return reinterpret_cast< const_pointer >( _storage.bytes );
+    }
+
+private:
+    void _use_storage() {
+        this->_data     = reinterpret_cast< pointer >( _storage.bytes );
+        this->_capacity = N;
+    }
+
+    const base_type &_base() const { return *this; }
+
+    /*
+     * Drops our elements for other's. Inline ones move one by one, to the
+     * N we hold at least. A heap buffer is stolen, other goes back inline.
+     */
+    void _take( small_vector &other ) {
+        if ( this == &other ) { return; }
+        this->clear();
+        if ( other._is_inline() ) {
+            ft::_relocate_a( other._data,
+                             other._data + other._size,
+                             this->_data,
+                             this->_allocator );
+            this->_size = other._size;
+            other._size = 0;
+            return;
+        }
+        this->_deallocate( this->_data, this->_allocated );
+        this->_steal( other );
+        other._use_storage();
+    }
+
+    /* The base destructor would hand the inline buffer to the allocator */
+    void _drop_storage() {
+        this->clear();
+        if ( this->_data == _inline_storage() ) {
+            this->_data     = 0;
+            this->_capacity = 0;
+        }
+    }
+};
+
+/* ---------------------------------- Swap ---------------------------------- */
+
+template < typename T, std::size_t N, typename A, typename G >
+void swap( small_vector< T, N, A, G > &x, small_vector< T, N, A, G > &y ) {
+    x.swap( y );
+}
+
+/* -------------------------------- Erase if -------------------------------- */
+
+template < typename T,
+           std::size_t N,
+           typename A,
+           typename G,
+           typename Predicate >
+typename small_vector< T, N, A, G >::size_type
+erase_if( small_vector< T, N, A, G > &c, Predicate pred ) {
+    return c.erase_if( pred );
+}
+
+/* -------------------------------------------------------------------------- */
+
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include "_uninitialized.hpp"
+#include "utility.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+namespace ft {
+
+/* -------------------------------- SPSC ring ------------------------------- */
+
+/*
+ * A bounded queue from one producer thread to one consumer thread, without
+ * locks. Positions only ever grow, the slot is the position masked by the
+ * capacity, a power of two: tail - head is the size, wraps included.
+ *
+ * Each side owns its index on a cache line of its own, next to its last
+ * look at the other's. It reads the other index only when that stale copy
+ * says full or empty, so the line ping-pongs once per batch at most, not
+ * once per element. Publishing an index is a release store, reading the
+ * other's an acquire load: elements are built before they can be seen.
+ */
+template < typename T, typename Allocator = std::allocator< T > >
+class spsc_ring {
+
+    /* ------------------------------ Member types ------------------------------ */
+
+public:
+    typedef T                                  value_type;
+    typedef Allocator                          allocator_type;
+    typedef typename allocator_type::pointer   pointer;
+    typedef typename allocator_type::reference reference;
+    typedef std::size_t                        size_type;
+
+    enum { CACHE_LINE = 64 };
+
+    /* ------------------------------- Attributes ------------------------------- */
+
+private:
+    /* Written once, read by both sides */
+    allocator_type _allocator;
+    pointer        _buffer;
+    size_type      _mask;
+    char           _pad0[CACHE_LINE];
+
+    /* The consumer's */
+    size_type _head;
+    size_type _tail_cache;
+    char      _pad1[CACHE_LINE];
+
+    /* The producer's */
+    size_type _tail;
+    size_type _head_cache;
+    char      _pad2[CACHE_LINE];
+
+    spsc_ring( const spsc_ring & );
+    spsc_ring &operator=( const spsc_ring & );
+
+    /* ------------------------------ Construction ------------------------------ */
+
+public:
+    /* Room for capacity elements at least, rounded up to a power of two */
+    explicit spsc_ring( size_type             capacity,
+                        const allocator_type &alloc = allocator_type() )
+        : _allocator( alloc ),
+          _buffer( 0 ),
+          _mask( 0 ),
+          _head( 0 ),
+          _tail_cache( 0 ),
+          _tail( 0 ),
+          _head_cache( 0 ) {
+        size_type n = 1;
+        while ( n < capacity ) { n <<= 1; }
+        _buffer = _allocator.allocate( n );
+        _mask   = n - 1;
+    }
+
+    ~spsc_ring() {
+        size_type head = _head & _mask;
+        size_type n    = _tail - _head;
+        size_type k    = std::min( n, capacity() - head );
+        ft::_destroy( _buffer + head, _buffer + head + k, _allocator );
+        ft::_destroy( _buffer, _buffer + ( n - k ), _allocator );
+        _allocator.deallocate( _buffer, capacity() );
+    }
+
+    /* -------------------------------- Capacity -------------------------------- */
+
+    size_type capacity() const { return _mask + 1; }
+
+    /* Exact from either side when the other is idle, a snapshot otherwise */
+    size_type size() const {
+        size_type head = __atomic_load_n( &_head, __ATOMIC_ACQUIRE );
+        return __atomic_load_n( &_tail, __ATOMIC_ACQUIRE ) - head;
+    }
+
+    bool empty() const { return !size(); }
+
+    /* -------------------------------- Producer -------------------------------- */
+
+    bool try_push( const value_type &val ) {
+        if ( !_free_slots( 1 ) ) { return false; }
+        _allocator.construct( _slot( _tail ), val );
+        __atomic_store_n( &_tail, _tail + 1, __ATOMIC_RELEASE );
+        return true;
+    }
+
+#if __cplusplus >= 201103L
+    bool try_push( value_type &&val ) {
+        return try_emplace( std::move( val ) );
+    }
+
+    template < typename... Args > bool try_emplace( Args &&...args ) {
+        typedef std::allocator_traits< allocator_type > traits;
+        if ( !_free_slots( 1 ) ) { return false; }
+        traits::construct( _allocator,
+                           _slot( _tail ),
+                           std::forward< Args >( args )... );
+        __atomic_store_n( &_tail, _tail + 1, __ATOMIC_RELEASE );
+        return true;
+    }
+#endif
+
+    /*
+     * Copies as many of the n elements from first as there is room for,
+     * in at most two runs, and publishes them all with a single store.
+     * Returns how many went in.
+     */
+    template < typename ForwardIterator >
+    size_type try_push_n( ForwardIterator first, size_type n ) {
+        n = std::min( n, _free_slots( n ) );
+        if ( !n ) { return 0; }
+        size_type       i = _tail & _mask;
+        size_type       k = std::min( n, capacity() - i );
+        ForwardIterator mid( first );
+        std::advance( mid, k );
+        ft::_uninitialized_copy_a( first, mid, _buffer + i, _allocator );
+        if ( k < n ) {
+            ForwardIterator last( mid );
+            std::advance( last, n - k );
+            try {
+                ft::_uninitialized_copy_a( mid, last, _buffer, _allocator );
+            } catch ( ... ) {
+                ft::_destroy( _buffer + i, _buffer + i + k, _allocator );
+                throw;
+            }
+        }
+        __atomic_store_n( &_tail, _tail + n, __ATOMIC_RELEASE );
+        return n;
+    }
+
+    /* -------------------------------- Consumer -------------------------------- */
+
+    bool try_pop( value_type &val ) {
+        if ( !_used_slots( 1 ) ) { return false; }
+        pointer slot = _slot( _head );
+        val          = ft::_move( *slot );
+        _allocator.destroy( slot );
+        __atomic_store_n( &_head, _head + 1, __ATOMIC_RELEASE );
+        return true;
+    }
+
+    /*
+     * Moves up to n elements to out, then frees their slots with a single
+     * store. Returns how many came out.
+     */
+    template < typename OutputIterator >
+    size_type try_pop_n( OutputIterator out, size_type n ) {
+        n = std::min( n, _used_slots( n ) );
+        if ( !n ) { return 0; }
+        size_type i = _head & _mask;
+        size_type k = std::min( n, capacity() - i );
+        out         = _move_out( _buffer + i, _buffer + i + k, out );
+        _move_out( _buffer, _buffer + ( n - k ), out );
+        ft::_destroy( _buffer + i, _buffer + i + k, _allocator );
+        ft::_destroy( _buffer, _buffer + ( n - k ), _allocator );
+        __atomic_store_n( &_head, _head + n, __ATOMIC_RELEASE );
+        return n;
+    }
+
+    /* ---------------------------------- Slots --------------------------------- */
+
+private:
+    pointer _slot( size_type position ) {
+        return _buffer + ( position & _mask );
+    }
+
+    /* Free slots, the consumer's index reloaded if fewer than want */
+    size_type _free_slots( size_type want ) {
+        size_type free = capacity() - ( _tail - _head_cache );
+        if ( free < want ) {
+            _head_cache = __atomic_load_n( &_head, __ATOMIC_ACQUIRE );
+            free        = capacity() - ( _tail - _head_cache );
+        }
+        return free;
+    }
+
+    /* Published elements, the producer's index reloaded if fewer than want */
+    size_type _used_slots( size_type want ) {
+        size_type used = _tail_cache - _head;
+        if ( used < want ) {
+            _tail_cache = __atomic_load_n( &_tail, __ATOMIC_ACQUIRE );
+            used        = _tail_cache - _head;
+        }
+        return used;
+    }
+
+    template < typename OutputIterator >
+    static OutputIterator
+    _move_out( pointer first, pointer last, OutputIterator out ) {
+        for ( ; first != last; first++, out++ ) { *out = ft::_move( *first ); }
+        return out;
+    }
+
+public:
+    /* -------------------------------- Allocator ------------------------------- */
+
+    allocator_type get_allocator() const { return _allocator; }
+
+    /* -------------------------------------------------------------------------- */
+};
+
+/* -------------------------------------------------------------------------- */
+
+}
@@ -1,10 +1,12 @@
 #pragma once
 
+#include "deque.hpp"
 #include "vector.hpp"
 
 namespace ft {
 
-template < typename T, typename Container = vector< T > > class stack {
+/* Backed by a deque, as std::stack is: growing never moves the elements */
+template < typename T, typename Container = deque< T > > class stack {
 
 public:
     typedef Container                                container_type;
@@ -45,6 +45,45 @@ template <> struct is_integral< long > : public true_type {};
 
 template <> struct is_integral< unsigned long > : public true_type {};
 
+/* --------------------------------- is_same -------------------------------- */
+
+template < typename T, typename U > struct is_same : public false_type {};
+
+template < typename T > struct is_same< T, T > : public true_type {};
+
+/* ------------------------------ remove_const ------------------------------ */
+
+template < typename T > struct remove_const {
+    typedef T type;
+};
+
+template < typename T > struct remove_const< const T > {
+    typedef T type;
+};
+
+/* -------------------------- is_trivially_copyable ------------------------- */
+
+/* Copies are byte copies, specialize to override what the compiler says */
+template < typename T >
+struct is_trivially_copyable
+#ifdef __GNUG__
+    : public integral_constant< bool, __is_trivially_copyable( T ) > {
+#else
+    : public is_integral< T > {
+#endif
+};
+
+/* ------------------------ is_trivially_relocatable ------------------------ */
+
+/*
+ * Moving an object to new storage and dropping the old one is a byte copy.
+ * True of trivially copyable types, and of most handle types owning their
+ * resources through pointers: specialize to true_type to opt one in.
+ */
+template < typename T >
+struct is_trivially_relocatable
+    : public integral_constant< bool, is_trivially_copyable< T >::value > {};
+
 /* -------------------------------------------------------------------------- */
 
 }
\ No newline at end of file
@@ -1,6 +1,18 @@
 #pragma once
 
+#if __cplusplus >= 201103L
+#include <utility>
+#endif
+
 namespace ft {
+
+/* std::move where there is one, a plain reference for copies in C++98 */
+#if __cplusplus >= 201103L
+template < typename T > T &&_move( T &x ) { return std::move( x ); }
+#else
+template < typename T > T &_move( T &x ) { return x; }
+#endif
+
 template < typename T, typename V > struct pair {
     typedef T first_type;
     typedef V second_type;
@@ -22,10 +34,10 @@ template < typename T, typename V > struct pair {
     }
     bool operator<( const pair &other ) const {
         return first < other.first
-               || ( !( first < other.first ) && second < other.second );
+               || ( !( other.first < first ) && second < other.second );
     }
     bool operator!=( const pair &other ) const { return !( *this == other ); }
-    bool operator<=( const pair &other ) const { return !( *this < other ); }
+    bool operator<=( const pair &other ) const { return !( other < *this ); }
     bool operator>( const pair &other ) const { return ( other < *this ); }
     bool operator>=( const pair &other ) const { return !( *this < other ); }
 };
@@ -2,16 +2,31 @@
 
 #include "_uninitialized.hpp"
 #include "algorithm.hpp"
+#include "growth_policy.hpp"
 #include "iterator.hpp"
+#include "mmap_allocator.hpp"
 #include "type_traits.hpp"
+#include "utility.hpp"
 #include <algorithm>
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <utility>
 
 namespace ft {
 
-template < typename T, typename Allocator = std::allocator< T > > class vector {
+/* ------------------------------ Default init ------------------------------ */
+
+/* Asks for default-initialized elements, trivial ones keep what memory held */
+struct default_init_t {};
+static const default_init_t default_init = default_init_t();
+
+/* -------------------------------------------------------------------------- */
+
+template < typename T,
+           typename Allocator = std::allocator< T >,
+           typename Growth    = ft::growth_double >
+class vector {
 
     /* -------------------------------- Iterator -------------------------------- */
 
@@ -22,6 +37,7 @@ template < typename T, typename Allocator = std::allocator< T > > class vector {
         typedef value_type                     *pointer;
         typedef std::ptrdiff_t                  difference_type;
         typedef std::random_access_iterator_tag iterator_category;
+        typedef ft::contiguous_iterator_tag     iterator_concept;
 
     private:
         pointer _p;
@@ -131,6 +147,8 @@ protected:
     pointer        _data;
     size_type      _capacity;
     size_type      _size;
+    /* What _data was allocated for, _capacity can be more: Growth::usable */
+    size_type      _allocated;
 
     /* ------------------------------ Construction ------------------------------ */
 
@@ -139,7 +157,8 @@ public:
         : _allocator( alloc ),
           _data( 0 ),
           _capacity( 0 ),
-          _size( 0 ) {}
+          _size( 0 ),
+          _allocated( 0 ) {}
 
     explicit vector( size_type             n,
                      const value_type     &val   = value_type(),
@@ -147,11 +166,23 @@ public:
         : _allocator( alloc ),
           _data( 0 ),
           _capacity( 0 ),
-          _size( 0 ) {
+          _size( 0 ),
+          _allocated( 0 ) {
         reserve( n );
         assign( n, val );
     }
 
+    vector( size_type             n,
+            default_init_t,
+            const allocator_type &alloc = allocator_type() )
+        : _allocator( alloc ),
+          _data( 0 ),
+          _capacity( 0 ),
+          _size( 0 ),
+          _allocated( 0 ) {
+        resize( n, default_init );
+    }
+
     template < class U >
     vector(
         U                     first,
@@ -161,7 +192,8 @@ public:
         : _allocator( alloc ),
           _data( 0 ),
           _capacity( 0 ),
-          _size( 0 ) {
+          _size( 0 ),
+          _allocated( 0 ) {
         assign( first, last );
     }
 
@@ -169,13 +201,14 @@ public:
         : _allocator( other._allocator ),
           _data( 0 ),
           _capacity( 0 ),
-          _size( 0 ) {
+          _size( 0 ),
+          _allocated( 0 ) {
         *this = other;
     }
 
     virtual ~vector() {
         clear();
-        _allocator.deallocate( _data, _capacity );
+        _deallocate( _data, _allocated );
     }
 
     vector &operator=( const vector &other ) {
@@ -183,6 +216,27 @@ public:
         return *this;
     }
 
+#if __cplusplus >= 201103L
+    /* Inline buffers never get here: small_vector is no vector to others */
+    vector( vector &&other ) noexcept
+        : _allocator( std::move( other._allocator ) ),
+          _data( 0 ),
+          _capacity( 0 ),
+          _size( 0 ),
+          _allocated( 0 ) {
+        _steal( other );
+    }
+
+    vector &operator=( vector &&other ) noexcept {
+        if ( this != &other ) {
+            clear();
+            _deallocate( _data, _allocated );
+            _steal( other );
+        }
+        return *this;
+    }
+#endif
+
     /* -------------------------------- Capacity -------------------------------- */
 
     size_type size() const { return _size; }
@@ -197,6 +251,26 @@ public:
         }
     }
 
+    void resize( size_type n, default_init_t ) {
+        if ( n > _size ) {
+            _grow( n - _size );
+            ft::_uninitialized_default( _data + _size, _data + n );
+            _size = n;
+        } else {
+            erase( begin() + n, end() );
+        }
+    }
+
+    /*
+     * op( data(), n ) writes into a buffer of n elements, the ones past the
+     * old size default-initialized, and returns how many to keep, at most n.
+     */
+    template < typename Operation >
+    void resize_and_overwrite( size_type n, Operation op ) {
+        resize( n, default_init );
+        erase( begin() + op( _data, n ), end() );
+    }
+
     size_type capacity() const { return _capacity; }
 
     bool empty() const { return !_size; }
@@ -204,12 +278,12 @@ public:
     void reserve( size_type n ) {
         if ( n > max_size() ) { throw std::length_error( "" ); }
         if ( n > _capacity ) {
-            pointer tmp = _allocator.allocate( n );
-            ft::_uninitialized_copy_a( _data, _data + _size, tmp, _allocator );
-            ft::_destroy( _data, _data + _size, _allocator );
-            _allocator.deallocate( _data, _capacity );
-            _capacity = n;
-            _data     = tmp;
+            pointer tmp = _data && !_is_inline()
+                              ? _reallocate( n, _remaps() )
+                              : _reallocate( n, ft::false_type() );
+            _capacity  = Growth::usable( tmp, n, sizeof( value_type ) );
+            _allocated = n;
+            _data      = tmp;
         }
     }
 
@@ -261,12 +335,59 @@ public:
         insert( begin(), n, val );
     }
 
+    /* When full, val may be an element: it is copied before the buffer goes */
     void push_back( const value_type &val ) {
-        if ( _size == _capacity ) { reserve( ( _size << 1 ) | !_size ); }
-        _allocator.construct( _data + _size, val );
+        if ( _size == _capacity ) {
+            value_type tmp( val );
+            _grow( 1 );
+            _allocator.construct( _data + _size, ft::_move( tmp ) );
+        } else {
+            _allocator.construct( _data + _size, val );
+        }
+        _size++;
+    }
+
+#if __cplusplus >= 201103L
+    void push_back( value_type &&val ) { emplace_back( std::move( val ) ); }
+
+    /* When full, the value is built before the buffer goes, as in emplace */
+    template < typename... Args > void emplace_back( Args &&...args ) {
+        typedef std::allocator_traits< allocator_type > traits;
+        if ( _size == _capacity ) {
+            value_type tmp( std::forward< Args >( args )... );
+            _grow( 1 );
+            traits::construct( _allocator, _data + _size, std::move( tmp ) );
+        } else {
+            traits::construct( _allocator,
+                               _data + _size,
+                               std::forward< Args >( args )... );
+        }
         _size++;
     }
 
+    /* Builds the value first, args may refer to elements about to move */
+    template < typename... Args >
+    iterator emplace( const_iterator position, Args &&...args ) {
+        difference_type i = position - begin();
+        if ( position == end() ) {
+            emplace_back( std::forward< Args >( args )... );
+        } else {
+            value_type tmp( std::forward< Args >( args )... );
+            _grow( 1 );
+            std::allocator_traits< allocator_type >::construct(
+                _allocator,
+                _data + _size,
+                std::move( _data[_size - 1] ) );
+            std::move_backward( _data + i,
+                                _data + _size - 1,
+                                _data + _size );
+            _data[i] = std::move( tmp );
+            _size++;
+        }
+        return begin() + i;
+    }
+#endif
+
     void pop_back() {
         if ( _size ) {
             _allocator.destroy( _data + _size - 1 );
@@ -280,10 +401,21 @@ public:
         return begin() + i;
     }
 
+    /* val may be an element, which growing or shifting would move: copied */
     void insert( iterator position, size_type n, const value_type &val ) {
         typename iterator::difference_type i = position - begin();
-        if ( _size + n > _capacity ) {
-            reserve( std::max( _size << 1, _size + n ) );
+        if ( !n ) { return; }
+        const value_type copy( val );
+        _grow( n );
+        if ( ft::is_trivially_relocatable< value_type >::value ) {
+            pointer p = _open( i, n );
+            try {
+                ft::_uninitialized_fill_a( p, p + n, copy, _allocator );
+            } catch ( ... ) {
+                _close( i, n );
+                throw;
+            }
+            return;
         }
         size_type x = std::min( n, _size - i );
         ft::_uninitialized_copy_a( _data + _size - x,
@@ -295,9 +427,9 @@ public:
                             _data + _size - x + n );
         ft::_uninitialized_fill_a( _data + _size,
                                    _data + _size - x + n,
-                                   val,
+                                   copy,
                                    _allocator );
-        std::fill( _data + i, _data + i + x, val );
+        ft::fill( _data + i, _data + i + x, copy );
         _size += n;
     }
 
@@ -307,10 +439,82 @@ public:
                  U        last,
                  typename ft::enable_if< !ft::is_integral< U >::value, U >::type
                      * = 0 ) {
-        size_type i = position - begin();
+        _insert_range(
+            position - begin(),
+            first,
+            last,
+            typename ft::iterator_traits< U >::iterator_category() );
+    }
+
+    iterator erase( iterator i ) { return erase( i, i + 1 ); }
+
+    iterator erase( iterator first, iterator last ) {
+        if ( ft::is_trivially_relocatable< value_type >::value ) {
+            ft::_destroy( first, last, _allocator );
+            _close( first - begin(), last - first );
+        } else {
+            std::copy( last, end(), first );
+            ft::_destroy( first + ( end() - last ), end(), _allocator );
+            _size -= last - first;
+        }
+        return first;
+    }
+
+    /* Erases the elements pred holds for, survivors slide down in one pass */
+    template < typename Predicate > size_type erase_if( Predicate pred ) {
+        pointer   p = std::remove_if( _data, _data + _size, pred );
+        size_type n = _data + _size - p;
+        erase( p, end() );
+        return n;
+    }
+
+    void swap( vector &other ) {
+        ft::swap( _data, other._data );
+        ft::swap( _capacity, other._capacity );
+        ft::swap( _size, other._size );
+        ft::swap( _allocated, other._allocated );
+    }
+
+    void clear() {
+        ft::_destroy( begin(), end(), _allocator );
+        _size = 0;
+    }
+
+    /* ------------------------------ Range insert ------------------------------ */
+
+private:
+    /* Single pass: append as push_back would, then rotate into place */
+    template < typename InputIterator >
+    void _insert_range( size_type     i,
+                        InputIterator first,
+                        InputIterator last,
+                        std::input_iterator_tag ) {
+        size_type n = _size;
+        try {
+            for ( ; first != last; ++first ) { push_back( *first ); }
+        } catch ( ... ) {
+            erase( begin() + n, end() );
+            throw;
+        }
+        std::rotate( begin() + i, begin() + n, end() );
+    }
+
+    template < typename ForwardIterator >
+    void _insert_range( size_type       i,
+                        ForwardIterator first,
+                        ForwardIterator last,
+                        std::forward_iterator_tag ) {
         size_type n = std::distance( first, last );
-        if ( _size + n > _capacity ) {
-            reserve( std::max( _size << 1, _size + n ) );
+        _grow( n );
+        if ( ft::is_trivially_relocatable< value_type >::value ) {
+            pointer p = _open( i, n );
+            try {
+                ft::_uninitialized_copy_a( first, last, p, _allocator );
+            } catch ( ... ) {
+                _close( i, n );
+                throw;
+            }
+            return;
         }
         size_type x = std::min( n, _size - i );
         ft::_uninitialized_copy_a( _data + _size - x,
@@ -320,33 +524,80 @@ public:
         std::copy_backward( _data + i,
                             _data + _size - x,
                             _data + _size - x + n );
-        U tmp( last );
-        std::advance( tmp, x - n );
-        std::copy( first, tmp, _data + i );
+        ForwardIterator tmp( first );
+        std::advance( tmp, x );
+        ft::copy( first, tmp, _data + i );
         ft::_uninitialized_copy_a( tmp, last, _data + _size, _allocator );
         _size += n;
     }
 
-    iterator erase( iterator i ) { return erase( i, i + 1 ); }
+    /* ------------------------------- Relocation ------------------------------- */
 
-    iterator erase( iterator first, iterator last ) {
-        std::copy( last, end(), first );
-        ft::_destroy( first + ( end() - last ), end(), _allocator );
-        _size -= last - first;
-        return first;
+protected:
+    /* Buffers of trivially relocatable types the allocator can move itself */
+    typedef ft::integral_constant<
+        bool,
+        ft::allocator_remaps< allocator_type >::value
+            && ft::is_trivially_relocatable< value_type >::value >
+        _remaps;
+
+    /* Moves the elements to a new buffer of n and releases the old one */
+    pointer _reallocate( size_type n, ft::true_type ) {
+        pointer tmp = _allocator.remap( _data, _allocated, n );
+        return tmp ? tmp : _reallocate( n, ft::false_type() );
+    }
+    pointer _reallocate( size_type n, ft::false_type ) {
+        pointer tmp = _allocator.allocate( n );
+        ft::_relocate_a( _data, _data + _size, tmp, _allocator );
+        _deallocate( _data, _allocated );
+        return tmp;
     }
 
-    void swap( vector &other ) {
-        ft::swap( _data, other._data );
-        ft::swap( _capacity, other._capacity );
-        ft::swap( _size, other._size );
+    /* Makes room for n more elements, as much as Growth says */
+    void _grow( size_type n ) {
+        if ( _size + n > _capacity ) {
+            size_type len = Growth::next( _size, _size + n );
+            reserve( std::max( _size + n, std::min( len, max_size() ) ) );
+        }
     }
 
-    void clear() {
-        ft::_destroy( begin(), end(), _allocator );
-        _size = 0;
+    /* Opens n raw slots at i, trivially relocatable types only */
+    pointer _open( size_type i, size_type n ) {
+        ft::_relocate_bytes( _data + i, _data + _size, _data + i + n );
+        _size += n;
+        return _data + i;
+    }
+
+    /* Closes the n raw slots at i */
+    void _close( size_type i, size_type n ) {
+        ft::_relocate_bytes( _data + i + n, _data + _size, _data + i );
+        _size -= n;
     }
 
+    /* --------------------------------- Storage -------------------------------- */
+
+    /* Buffer living inside a derived object, small_vector's one */
+    virtual const_pointer _inline_storage() const { return 0; }
+
+    bool _is_inline() const { return _data && _data == _inline_storage(); }
+
+    void _deallocate( pointer p, size_type n ) {
+        if ( p != _inline_storage() ) { _allocator.deallocate( p, n ); }
+    }
+
+    /* Takes other's heap buffer, leaving it empty, ours already released */
+    void _steal( vector &other ) {
+        _data            = other._data;
+        _capacity        = other._capacity;
+        _size            = other._size;
+        _allocated       = other._allocated;
+        other._data      = 0;
+        other._capacity  = 0;
+        other._size      = 0;
+        other._allocated = 0;
+    }
+
+public:
     /* -------------------------------- Allocator ------------------------------- */
 
     allocator_type get_allocator() const { return _allocator; }
@@ -354,14 +605,15 @@ public:
     /* -------------------------- Relational operators -------------------------- */
 
     bool operator==( const vector &other ) const {
-        return size() == other.size() && equal( begin(), end(), other.begin() );
+        return size() == other.size()
+               && ft::equal( begin(), end(), other.begin() );
     }
     bool operator!=( const vector &other ) const { return !( *this == other ); }
     bool operator<( const vector &other ) const {
-        return lexicographical_compare( begin(),
-                                        end(),
-                                        other.begin(),
-                                        other.end() );
+        return ft::lexicographical_compare( begin(),
+                                            end(),
+                                            other.begin(),
+                                            other.end() );
     }
     bool operator<=( const vector &other ) const {
         return *this == other || *this < other;
@@ -374,11 +626,19 @@ public:
 
 /* ---------------------------------- Swap ---------------------------------- */
 
-template < typename T, typename A >
-void swap( vector< T, A > &x, vector< T, A > &y ) {
+template < typename T, typename A, typename G >
+void swap( vector< T, A, G > &x, vector< T, A, G > &y ) {
     x.swap( y );
 }
 
+/* -------------------------------- Erase if -------------------------------- */
+
+template < typename T, typename A, typename G, typename Predicate >
+typename vector< T, A, G >::size_type erase_if( vector< T, A, G > &c,
+                                                Predicate          pred ) {
+    return c.erase_if( pred );
+}
+
 /* -------------------------------------------------------------------------- */
 
 }